@@ -0,0 +1,136 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*! \file approximation.cpp
+ * Benchmark of the approximations. Every approximation type runs with every metric of metricgraph.hpp on the same
+ * random instance, and on the euclidean instance renumbered along a Hilbert curve. The runtime is timed and the a
+ * fortiori guarantee is checked: it is at least 1 for every metric and at most 2 for metrics that satisfy the triangle
+ * inequality. The exit code is 1 if a guarantee is violated.
+ * Usage: ./benchmark-approximation [<numberOfNodes>] [<repetitions>]
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// graph library
+#include "graph.hpp"
+
+#include "solve/approximation.hpp"
+#include "solve/definitions.hpp"
+#include "solve/euclideandistancegraph.hpp"
+#include "solve/hilbertorder.hpp"
+#include "solve/metricgraph.hpp"
+
+#include "utility/utils.hpp"
+
+constexpr size_t DEFAULT_NUMBER_OF_NODES = 2000;
+constexpr size_t DEFAULT_REPETITIONS     = 5;
+constexpr std::array<uint_fast32_t, SEED_LENGTH> SEED{42};  // fixed, so that runs are comparable
+
+constexpr std::array<ProblemType, 3> APPROXIMATION_TYPES{ProblemType::BTSP_approx, ProblemType::BTSPP_approx, ProblemType::BTSVPP_approx};
+
+template <typename G>
+static approximation::Result approximate(const G& graph, const ProblemType type) {
+  switch (type) {
+  case ProblemType::BTSP_approx:
+    return approximation::approximateBTSP<approximation::ResultPolicy::Compact>(graph);
+  case ProblemType::BTSPP_approx:
+    return approximation::approximateBTSPP<approximation::ResultPolicy::Compact>(graph);
+  default:
+    return approximation::approximateBTSVPP<approximation::ResultPolicy::Compact>(graph);
+  }
+}
+
+/*!
+ * @brief approximates every type repetitions times, prints the fastest runtime and the guarantee
+ * @tparam METRIC true if the weights satisfy the triangle inequality, so that the guarantee is at most 2
+ * @param approximate callable that takes a problem type and returns the approximation
+ * @return false if a guarantee is violated
+ */
+template <bool METRIC, typename Approximate>
+static bool benchmark(const std::string_view name, const size_t repetitions, Approximate approximate) {
+  bool valid = true;
+  for (const ProblemType type : APPROXIMATION_TYPES) {
+    double fastest = -1.0;
+    double ratio   = 0.0;
+    Stopwatch stopWatch;
+    for (size_t i = 0; i < repetitions; ++i) {
+      stopWatch.reset();
+      const approximation::Result result = approximate(type);
+      const double runtime               = stopWatch.elapsedTimeInMilliseconds();
+      fastest                            = fastest < 0.0 ? runtime : std::min(fastest, runtime);
+      ratio                              = result.objective / result.lowerBoundOnOPT;
+    }
+    const bool violated = ratio < 1.0 || (METRIC && ratio > 2.0);
+    valid               = valid && !violated;
+    std::cout << "  " << std::left << std::setw(18) << name << std::setw(10) << type << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << fastest << " ms" << std::setprecision(3) << std::setw(8) << ratio << (violated ? "  violated" : "")
+              << std::defaultfloat << "\n";
+  }
+  return valid;
+}
+
+/*!
+ * @brief approximates every type repetitions times on graph
+ * @return false if a guarantee is violated
+ */
+template <typename G>
+static bool benchmarkGraph(const std::string_view name, const G& graph, const size_t repetitions) {
+  return benchmark<approximation::satisfiesTriangleInequality<G>()>(
+      name, repetitions, [&graph](const ProblemType type) { return approximate(graph, type); });
+}
+
+/*!
+ * @brief approximates every type repetitions times on euclidean renumbered along a Hilbert curve, as with -hilbert
+ * @details The time includes the reordering and restoring the ids, so it compares directly to the euclidean rows.
+ * @return false if a guarantee is violated
+ */
+static bool benchmarkHilbertOrder(const graph::Euclidean& euclidean, const size_t repetitions) {
+  return benchmark<true>("euclidean+hilbert", repetitions, [&euclidean](const ProblemType type) {
+    const hilbertorder::Reordering reordering(euclidean);
+    return reordering.restore(approximate(reordering.graph(), type));
+  });
+}
+
+int main(int argc, char* argv[]) {
+  const size_t numberOfNodes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_NUMBER_OF_NODES;
+  const size_t repetitions   = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : DEFAULT_REPETITIONS;
+  if (numberOfNodes < 3 || repetitions == 0) {
+    std::cerr << "Usage: " << argv[0] << " [<numberOfNodes> >= 3] [<repetitions> >= 1]" << std::endl;
+    return -1;
+  }
+
+  const graph::Euclidean euclidean = generateEuclideanDistanceGraph(numberOfNodes, SEED, true);
+  std::cout << "approximations of " << numberOfNodes << " nodes, fastest of " << repetitions << " runs, a fortiori guarantee\n";
+  bool valid = true;
+  valid      = benchmarkGraph("euclidean", euclidean, repetitions) && valid;
+  valid      = benchmarkHilbertOrder(euclidean, repetitions) && valid;
+  valid      = benchmarkGraph("squared-euclidean", MetricGraph<metric::SquaredEuclidean>(euclidean.vertices()), repetitions) && valid;
+  valid      = benchmarkGraph("manhattan", MetricGraph<metric::Manhattan>(euclidean.vertices()), repetitions) && valid;
+  valid      = benchmarkGraph("chebyshev", MetricGraph<metric::Chebyshev>(euclidean.vertices()), repetitions) && valid;
+  valid      = benchmarkGraph("haversine", MetricGraph<metric::Haversine>(euclidean.vertices()), repetitions) && valid;
+  return valid ? 0 : 1;
+}
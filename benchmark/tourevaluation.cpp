@@ -0,0 +1,114 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*! \file tourevaluation.cpp
+ * Micro benchmark of the bottleneck search on euclidean tours. It compares the generic findBottleneck() with the
+ * vectorised kernel of tourevaluation, on a tour in node order and on a shuffled tour.
+ * Usage: ./benchmark-tourevaluation [<numberOfNodes>] [<repetitions>]
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+// graph library
+#include "graph.hpp"
+
+#include "solve/commonfunctions.hpp"
+#include "solve/tourevaluation.hpp"
+
+#include "utility/utils.hpp"
+
+constexpr size_t DEFAULT_NUMBER_OF_NODES = 1000000;
+constexpr size_t DEFAULT_REPETITIONS     = 20;
+constexpr unsigned int SEED              = 42;  // fixed, so that runs are comparable
+
+/*!
+ * @brief runs kernel repetitions times and prints the fastest and the median runtime
+ * @return bottleneck edge found by the last run, to check that all kernels agree
+ */
+template <typename Kernel>
+static graph::Edge measure(const std::string& name, const size_t repetitions, Kernel kernel) {
+  std::vector<double> runtimes;
+  graph::Edge bottleneck{0, 0};
+  Stopwatch stopWatch;
+  for (size_t i = 0; i < repetitions; ++i) {
+    stopWatch.reset();
+    bottleneck = kernel();
+    runtimes.push_back(stopWatch.elapsedTimeInMilliseconds());
+  }
+  std::sort(runtimes.begin(), runtimes.end());
+  std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2) << std::setw(9)
+            << runtimes.front() << " ms min" << std::setw(9) << runtimes[runtimes.size() / 2] << " ms median\n";
+  return bottleneck;
+}
+
+static bool sameEdge(const graph::Edge& e, const graph::Edge& f) {
+  return e.u == f.u && e.v == f.v;
+}
+
+static void benchmarkTour(const std::string& name,
+                          const graph::Euclidean& euclidean,
+                          const std::vector<size_t>& tour,
+                          const size_t repetitions) {
+  std::cout << name << " tour of " << tour.size() << " nodes\n";
+  const std::vector<graph::Point2D>& positions = euclidean.vertices();
+
+  // the generic template compares squared distances edge by edge, like findBottleneck() on other graphs
+  const graph::Edge generic = measure("findBottleneck<Euclidean>", repetitions, [&] {
+    return findBottleneck<graph::Euclidean>(euclidean, tour, true);
+  });
+  const graph::Edge vectorised = measure("evaluateBottleneck", repetitions, [&] {
+    return tourevaluation::edgeAt(tour, tourevaluation::evaluateBottleneck(positions, tour, true).bottleneckPosition);
+  });
+
+  if (!sameEdge(generic, vectorised)) {
+    std::cout << "  kernels disagree on the bottleneck edge\n";
+  }
+}
+
+int main(int argc, char* argv[]) {
+  const size_t numberOfNodes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_NUMBER_OF_NODES;
+  const size_t repetitions   = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : DEFAULT_REPETITIONS;
+  if (numberOfNodes < 2 || repetitions == 0) {
+    std::cerr << "Usage: " << argv[0] << " [<numberOfNodes> >= 2] [<repetitions> >= 1]" << std::endl;
+    return -1;
+  }
+
+  std::default_random_engine generator(SEED);
+  std::uniform_real_distribution<double> distribution(-0.95, 0.95);
+  std::vector<graph::Point2D> positions(numberOfNodes);
+  for (graph::Point2D& point : positions) {
+    point.x = distribution(generator);
+    point.y = distribution(generator);
+  }
+  const graph::Euclidean euclidean(positions);
+
+  std::vector<size_t> tour(numberOfNodes);
+  std::iota(tour.begin(), tour.end(), 0);
+  benchmarkTour("ordered", euclidean, tour, repetitions);
+  std::shuffle(tour.begin(), tour.end(), generator);
+  benchmarkTour("shuffled", euclidean, tour, repetitions);
+  return 0;
+}
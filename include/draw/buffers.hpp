@@ -18,7 +18,9 @@
  */
 #pragma once
 
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -73,6 +75,23 @@ public:
   template <typename Type>
   void bufferSubData(const std::vector<Type>& dat) const;
 
+  /*!
+   * \brief replaces a range of the data in OpenGL with the corresponding range of dat
+   * \details calls bind(), copies count elements of dat starting at first to the same position in the buffer
+   * \param dat data to be copied
+   * \param first index of the first element to be copied
+   * \param count number of elements to be copied
+   */
+  template <typename Type>
+  void bufferSubData(const std::vector<Type>& dat, const size_t first, const size_t count) const;
+
+  /*!
+   * \brief binds this buffer to the indexed binding point of GL_SHADER_STORAGE_BUFFER
+   * \details This way the same data can be read as vertex attribute and as shader storage buffer.
+   * \param bindingPoint position to bind the buffer (like an address)
+   */
+  void bindBase(const GLuint bindingPoint) const { GL_CALL(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindingPoint, pID);) }
+
   /*!
    * \brief compPerVertex returns the number of basic variables per vertex
    * \return number of basic variables per vertex
@@ -141,6 +160,12 @@ public:
   template <typename Type>
   void bufferSubData(const std::vector<Type>& dat) const;
 
+  /*!
+   * \brief binds this buffer to the indexed binding point of GL_SHADER_STORAGE_BUFFER
+   * \param bindingPoint position to bind the buffer (like an address)
+   */
+  void bindBase(const GLuint bindingPoint) const { GL_CALL(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindingPoint, pID);) }
+
   /*!
    * \brief returns OpenGL's internal id for the shader buffer object
    * \return OpenGL's internal id for the shader buffer object
@@ -151,6 +176,160 @@ private:
   GLuint pID; /**< this buffer's OpenGL ID */
 };
 
+/***********************************************************************************************************************
+ *                                               ElementBuffer class
+ **********************************************************************************************************************/
+
+/*!
+ * \brief ElementBuffer manages an OpenGL element array buffer, used to draw a subset of the vertices
+ */
+class ElementBuffer {
+public:
+  /*!
+   * \brief constructor, invokes glGenBuffers
+   */
+  ElementBuffer() { GL_CALL(glGenBuffers(1, &pID);) }
+
+  /*!
+   * \brief destructor, invokes glDeleteBuffers
+   */
+  ~ElementBuffer() { GL_CALL(glDeleteBuffers(1, &pID);) }
+
+  /*!
+   * \brief binds this buffer as GL_ELEMENT_ARRAY_BUFFER, this is stored in the currently bound vertex array
+   */
+  void bind() const { GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pID);) }
+
+  /*!
+   * \brief copies indices to OpenGL
+   * \details calls bind(), copies indices whith hint GL_DYNAMIC_DRAW to a new memory block associated with this buffer
+   * \param indices vertex indices
+   */
+  void bufferData(const std::vector<uint32_t>& indices) {
+    this->bind();
+    GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, bytes_of(indices), indices.data(), GL_DYNAMIC_DRAW);)
+    pSize = indices.size();
+  }
+
+  /*!
+   * \brief number of indices in the buffer
+   */
+  size_t size() const { return pSize; }
+
+private:
+  GLuint pID;       /**< this buffer's OpenGL ID */
+  size_t pSize = 0; /**< number of indices */
+};
+
+/***********************************************************************************************************************
+ *                                               UniformBuffer class
+ **********************************************************************************************************************/
+
+/*!
+ * \brief UniformBuffer manages an OpenGL uniform buffer object holding a single uniform block
+ */
+class UniformBuffer {
+public:
+  /*!
+   * \brief constructor, invokes glGenBuffers
+   */
+  UniformBuffer() { GL_CALL(glGenBuffers(1, &pID);) }
+
+  /*!
+   * \brief destructor, invokes glDeleteBuffers
+   */
+  ~UniformBuffer() { GL_CALL(glDeleteBuffers(1, &pID);) }
+
+  /*!
+   * \brief binds this buffer as GL_UNIFORM_BUFFER
+   */
+  void bind() const { GL_CALL(glBindBuffer(GL_UNIFORM_BUFFER, pID);) }
+
+  /*!
+   * \brief copies block to OpenGL
+   * \details calls bind(), copies block whith hint GL_DYNAMIC_DRAW to a new memory block associated with this buffer
+   * \param block data to be copied, the layout must match the std140 layout of the uniform block in the shaders
+   */
+  template <typename Block>
+  void bufferData(const Block& block) const;
+
+  /*!
+   * \brief binds this buffer to the indexed binding point of GL_UNIFORM_BUFFER
+   * \param bindingPoint position to bind the buffer (like an address)
+   */
+  void bindBase(const GLuint bindingPoint) const { GL_CALL(glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, pID);) }
+
+private:
+  GLuint pID; /**< this buffer's OpenGL ID */
+};
+
+/***********************************************************************************************************************
+ *                                               TourBuffer class
+ **********************************************************************************************************************/
+
+/*!
+ * \brief TourBuffer keeps the vertex orders of several tours in one persistently mapped shader storage buffer
+ * \details Every tour has its own region, every region consists of two slots. write() fills the slot that is not
+ * displayed and then swaps, so a tour is only uploaded when it changes. Each slot is guarded by a fence that is set
+ * after the last draw reading it, write() waits for it before the slot is overwritten.
+ */
+class TourBuffer {
+public:
+  /*!
+   * \brief constructor, allocates immutable storage with glBufferStorage and maps it persistently
+   * \param capacity maximal number of indices per tour
+   * \param numberOfRegions number of tours
+   */
+  TourBuffer(const size_t capacity, const size_t numberOfRegions);
+
+  /*!
+   * \brief destructor, unmaps the buffer, deletes the fences and the buffer
+   */
+  ~TourBuffer();
+
+  TourBuffer(const TourBuffer&)            = delete;
+  TourBuffer& operator=(const TourBuffer&) = delete;
+
+  /*!
+   * \brief copies order into the back slot of region and makes it the displayed slot
+   * \param region index of the tour
+   * \param order vertex indices, at most capacity many
+   */
+  void write(const size_t region, const std::vector<uint32_t>& order);
+
+  /*!
+   * \brief binds the displayed slot of region to bindingPoint of GL_SHADER_STORAGE_BUFFER
+   * \param region index of the tour
+   * \param bindingPoint position to bind the buffer (like an address)
+   */
+  void bindRange(const size_t region, const GLuint bindingPoint) const;
+
+  /*!
+   * \brief sets a fence for the displayed slot of region, needs to be called after the draw call reading it
+   * \param region index of the tour
+   */
+  void fence(const size_t region);
+
+  /*!
+   * \brief number of indices in the displayed slot of region
+   * \param region index of the tour
+   */
+  size_t size(const size_t region) const { return pSize[region]; }
+
+private:
+  static constexpr size_t SLOTS_PER_REGION = 2;
+
+  size_t slot(const size_t region, const size_t index) const { return SLOTS_PER_REGION * region + index; }
+
+  GLuint pID;                         /**< this buffer's OpenGL ID */
+  size_t pCapacity;                   /**< maximal number of indices per slot */
+  size_t pSlotStride;                 /**< distance between two slots in bytes, respects the offset alignment */
+  std::byte* pMapped;                 /**< persistently mapped storage */
+  std::vector<size_t> pDisplayedSlot; /**< index of the slot that is drawn per region */
+  std::vector<size_t> pSize;          /**< number of indices in the displayed slot per region */
+  std::vector<GLsync> pFences;        /**< fence per slot, nullptr if the slot hasn't been drawn */
+};
+
 /***********************************************************************************************************************
  *                                               VertexArray class
  **********************************************************************************************************************/
@@ -207,9 +386,9 @@ private:
  * \brief Buffers bundles various buffers
  */
 struct Buffers {
-  std::shared_ptr<VertexBuffer> coordinates;     /**< coordinates of graph vertices */
-  std::shared_ptr<ShaderBuffer> tour;            /**< vertex indeces in order as they appear in the tour */
-  std::shared_ptr<ShaderBuffer> tourCoordinates; /**< coordinates of graph vertices */
+  std::shared_ptr<VertexBuffer> coordinates;      /**< coordinates of graph vertices, also bound as shader storage buffer */
+  std::shared_ptr<TourBuffer> tours;              /**< vertex indeces in order as they appear in the tour, per problem type */
+  std::shared_ptr<ElementBuffer> representatives; /**< vertices drawn in the reduced level of detail */
 };
 
 /***********************************************************************************************************************
@@ -222,6 +401,19 @@ void VertexBuffer::bufferSubData(const std::vector<Type>& dat) const {
   GL_CALL(glBufferSubData(GL_ARRAY_BUFFER, 0, bytes_of(dat), dat.data());)  // 0 for no offset
 }
 
+template <typename Type>
+void VertexBuffer::bufferSubData(const std::vector<Type>& dat, const size_t first, const size_t count) const {
+  assert(first + count <= dat.size() && "range exceeds the data");
+  this->bind();
+  GL_CALL(glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(Type), count * sizeof(Type), dat.data() + first);)
+}
+
+template <typename Block>
+void UniformBuffer::bufferData(const Block& block) const {
+  this->bind();
+  GL_CALL(glBufferData(GL_UNIFORM_BUFFER, sizeof(Block), &block, GL_DYNAMIC_DRAW);)
+}
+
 template <typename Type>
 void ShaderBuffer::bufferData(const std::vector<Type>& dat) const {
   this->bind();
@@ -0,0 +1,77 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+
+// graph library
+#include "geometry.hpp"
+
+/*! \file camera.hpp */
+
+namespace drawing {
+constexpr double MIN_ZOOM = 1.0;  // the initial view already shows the whole unit square
+constexpr double MAX_ZOOM = 1000.0;
+
+/*!
+ * \brief Camera maps world coordinates to normalized device coordinates by a translation and a uniform scaling
+ */
+struct Camera {
+  graph::Point2D center{0.0, 0.0}; /**< world point in the middle of the window */
+  double zoom = 1.0;               /**< magnification, 1.0 shows [-1, 1] x [-1, 1] */
+
+  /*!
+   * \brief maps normalized device coordinates to world coordinates
+   * \param ndc point in normalized device coordinates
+   */
+  graph::Point2D toWorld(const graph::Point2D& ndc) const { return graph::Point2D{ndc.x / zoom + center.x, ndc.y / zoom + center.y}; }
+
+  /*!
+   * \brief maps world coordinates to normalized device coordinates
+   * \param world point in world coordinates
+   */
+  graph::Point2D toNdc(const graph::Point2D& world) const {
+    return graph::Point2D{(world.x - center.x) * zoom, (world.y - center.y) * zoom};
+  }
+
+  /*!
+   * \brief multiplies the zoom by factor, keeping the world point under ndc in place
+   * \param ndc fixed point in normalized device coordinates, usually the cursor
+   * \param factor zoom factor, values greater than 1 zoom in
+   */
+  void zoomAt(const graph::Point2D& ndc, const double factor) {
+    const graph::Point2D fixed = toWorld(ndc);
+    zoom                       = std::clamp(zoom * factor, MIN_ZOOM, MAX_ZOOM);
+    center                     = graph::Point2D{fixed.x - ndc.x / zoom, fixed.y - ndc.y / zoom};
+  }
+
+  /*!
+   * \brief moves the view such that the content follows a cursor movement of delta
+   * \param delta cursor movement in normalized device coordinates
+   */
+  void pan(const graph::Point2D& delta) {
+    center.x -= delta.x / zoom;
+    center.y -= delta.y / zoom;
+  }
+
+  bool operator==(const Camera& other) const {
+    return center.x == other.center.x && center.y == other.center.y && zoom == other.zoom;
+  }
+};
+}  // namespace drawing
@@ -45,12 +45,15 @@ constexpr std::array<ProblemType, static_cast<unsigned int>(ProblemType::NUMBER_
 }  // namespace problemType
 
 namespace drawing {
-constexpr bool INITIAL_SHOW_SETTINGS_WINDOW  = true;
-constexpr bool INITIAL_SHOW_DEBUG_WINDOW     = false;
-constexpr float VETREX_RADIUS                = 0.01f;
-constexpr int CIRCLE_STEPS                   = 8;
-constexpr float BOTLLENECK_EDGE_WIDTH_FACTOR = 2.0f;
-constexpr unsigned int PATH_OVERHEAD         = 3;
+constexpr bool INITIAL_SHOW_SETTINGS_WINDOW     = true;
+constexpr bool INITIAL_SHOW_DEBUG_WINDOW        = false;
+constexpr float VETREX_RADIUS                   = 0.01f;
+constexpr int CIRCLE_STEPS                      = 8;
+constexpr float BOTLLENECK_EDGE_WIDTH_FACTOR    = 2.0f;
+constexpr unsigned int PATH_OVERHEAD            = 3;
+constexpr unsigned int TOUR_BINDING_POINT       = 1;  // must match the binding of lineIndex in the path vertex shader
+constexpr unsigned int EDGE_LIST_BINDING_POINT  = 2;  // must match the binding of edgeList in the edge vertex shader
+constexpr unsigned int APPEARANCE_BINDING_POINT = 0;  // must match the binding of appearanceBlock in the shaders
 
 constexpr std::array<bool, static_cast<unsigned int>(ProblemType::NUMBER_OF_OPTIONS)> INITIAL_ACTIVENESS{
     false,  // BTSP_approx
@@ -77,6 +80,10 @@ constexpr bool INITIAL_BTSPP_DRAW_BICONNECTED_GRAPH     = false;
 constexpr bool INITIAL_BTSPP_DRAW_HAMILTON_PATH         = false;
 constexpr bool INITIAL_BTSVPP_DRAW_BICONNECTED_GRAPH    = false;
 constexpr bool INITIAL_BTSVPP_DRAW_HAMILTON_PATH        = false;
+constexpr bool INITIAL_LIVE_APPROXIMATION               = false;
+
+constexpr double LIVE_APPROXIMATION_INTERVAL = 30.0;  // minimal time between two live approximations in milliseconds
+constexpr std::array<ProblemType, 3> APPROXIMATION_TYPES{ProblemType::BTSP_approx, ProblemType::BTSPP_approx, ProblemType::BTSVPP_approx};
 
 constexpr std::array<float, static_cast<unsigned int>(ProblemType::NUMBER_OF_OPTIONS)> INITIAL_THICKNESS{
     4.0f,  // BTSP_approx
@@ -89,11 +96,15 @@ constexpr std::array<float, static_cast<unsigned int>(ProblemType::NUMBER_OF_OPT
 
 constexpr RGBA_COLOUR INITIAL_CLEAR_COLOUR  = {0.19, 0.19, 0.25, 1.0};
 constexpr RGBA_COLOUR INITIAL_VERTEX_COLOUR = {1.0f, 1.0f, 0.0f, 1.0f};
+constexpr RGBA_COLOUR HOVER_VERTEX_COLOUR   = {1.0f, 1.0f, 1.0f, 1.0f};
+constexpr float HOVER_RADIUS_FACTOR         = 1.5f;
+constexpr double ZOOM_STEP                  = 1.25;  // zoom factor per step of the scroll wheel
 }  // namespace drawing
 
 namespace input {
 namespace mouse {
 constexpr int INITIAL_NODE_IN_MOTION = namedInts::INVALID;
+constexpr int INITIAL_NODE_HOVERED   = namedInts::INVALID;
 }  // namespace mouse
 }  // namespace input
 
@@ -101,4 +112,5 @@ namespace mainwindow {
 constexpr unsigned int INITIAL_HEIGHT = 1000;
 constexpr unsigned int INITIAL_WIDTH  = 1000;
 constexpr const char* NAME            = "BTSPP";
+constexpr unsigned int REDRAW_FRAMES  = 3;  // frames drawn after a change, ImGui needs a few to settle hover states
 }  // namespace mainwindow
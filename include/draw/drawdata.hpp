@@ -18,13 +18,20 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <vector>
 
 // graph library
 #include "graph.hpp"
 
 #include "draw/buffers.hpp"
+#include "draw/camera.hpp"
+#include "draw/levelofdetail.hpp"
 
 #include "solve/definitions.hpp"
 
@@ -37,16 +44,53 @@ public:
   FloatVertices(const std::vector<float>& vertices) : pFloatVertices(vertices) {}
 
   /*!
-   * @brief casts the doubles in coordinates of euclidean into floatVertices
+   * @brief casts the doubles in coordinates of euclidean into floatVertices, marks all vertices as changed
    * @param euclidean
    */
   void updatePointsfFromEuclidean(graph::Euclidean& euclidean) {
-    pFloatVertices.resize(2 * euclidean.numberOfNodes());
-    const std::vector<graph::Point2D> points = euclidean.vertices();
+    const std::vector<graph::Point2D>& points = euclidean.vertices();
+    pFloatVertices.resize(2 * points.size());
     for (size_t i = 0; i < points.size(); ++i) {
       pFloatVertices[2 * i]     = static_cast<float>(points[i].x);
       pFloatVertices[2 * i + 1] = static_cast<float>(points[i].y);
     }
+    pDirtyBegin = 0;
+    pDirtyEnd   = pFloatVertices.size();
+  }
+
+  /*!
+   * @brief replaces the coordinates of vertex u and marks it as changed
+   * @param u vertex
+   * @param point new position of u
+   */
+  void updatePoint(const size_t u, const graph::Point2D& point) {
+    pFloatVertices[2 * u]     = static_cast<float>(point.x);
+    pFloatVertices[2 * u + 1] = static_cast<float>(point.y);
+    pDirtyBegin               = std::min(pDirtyBegin, 2 * u);
+    pDirtyEnd                 = std::max(pDirtyEnd, 2 * u + 2);
+  }
+
+  /*!
+   * @brief checks if any coordinates changed since the last call of clean()
+   */
+  bool dirty() const { return pDirtyBegin < pDirtyEnd; }
+
+  /*!
+   * @brief index of the first changed float
+   */
+  size_t dirtyBegin() const { return pDirtyBegin; }
+
+  /*!
+   * @brief number of floats in the changed range
+   */
+  size_t dirtyCount() const { return dirty() ? pDirtyEnd - pDirtyBegin : 0; }
+
+  /*!
+   * @brief marks all coordinates as uploaded
+   */
+  void clean() {
+    pDirtyBegin = std::numeric_limits<size_t>::max();
+    pDirtyEnd   = 0;
   }
 
   /*!
@@ -69,6 +113,92 @@ public:
 private:
   /*! vector of the vertices coordinates, order: x_0, y_0, x_1, y_1, ... */
   std::vector<float> pFloatVertices;
+  size_t pDirtyBegin = std::numeric_limits<size_t>::max(); /**< first float changed since the last upload */
+  size_t pDirtyEnd   = 0;                                  /**< one past the last float changed since the last upload */
+};
+
+/*!
+ * \brief EdgeList keeps a set of edges in a shader buffer, to draw all of them with a single instanced draw call
+ * \details The edges are uploaded once per solve. Moving vertices doesn't require a re-upload, because the shader looks
+ * up the coordinates of the end points in the vertex coordinate buffer.
+ */
+class EdgeList {
+public:
+  /*!
+   * \brief layout of an edge in the shader buffer, must match struct Edge in the edge vertex shader
+   */
+  struct GpuEdge {
+    uint32_t u;
+    uint32_t v;
+    float fade; /**< factor the colour's rgb components are multiplied with */
+  };
+
+  /*!
+   * \brief uploads all edges of graph
+   * \param graph graph providing edges()
+   */
+  template <typename G>
+  void update(const G& graph) {
+    std::vector<GpuEdge> edges;
+    edges.reserve(graph.numberOfEdges());
+    for (const graph::Edge& e : graph.edges()) {
+      edges.push_back(GpuEdge{static_cast<uint32_t>(e.u), static_cast<uint32_t>(e.v), 1.0f});
+    }
+    upload(edges);
+  }
+
+  /*!
+   * \brief uploads all edges of the ears, the i-th ear fades with i / (number of ears - 1)
+   * \param earDecomposition ear decomposition to be drawn
+   */
+  void update(const graph::EarDecomposition& earDecomposition) {
+    std::vector<GpuEdge> edges;
+    const size_t numberOfEars = earDecomposition.ears.size();
+    for (size_t i = 0; i < numberOfEars; ++i) {
+      const std::vector<size_t>& chain = earDecomposition.ears[i];
+      const float fade                 = (numberOfEars > 1 ? (float) i / (numberOfEars - 1) : 1.0f);
+      for (size_t j = chain.size() - 1; j > 0; --j) {
+        edges.push_back(GpuEdge{static_cast<uint32_t>(chain[j]), static_cast<uint32_t>(chain[j - 1]), fade});
+      }
+    }
+    upload(edges);
+  }
+
+  /*!
+   * \brief number of edges currently uploaded
+   */
+  size_t size() const { return pSize; }
+
+  /*!
+   * \brief binds the underlying shader buffer to bindingPoint, the list must not be empty
+   * \param bindingPoint binding point of the edge list in the edge vertex shader
+   */
+  void bindBase(const GLuint bindingPoint) const { pBuffer->bindBase(bindingPoint); }
+
+private:
+  void upload(const std::vector<GpuEdge>& edges) {
+    pSize = edges.size();
+    if (pSize == 0) {
+      return;
+    }
+    if (!pBuffer) {
+      pBuffer = std::make_shared<ShaderBuffer>();
+    }
+    pBuffer->bufferData(edges);
+  }
+
+  std::shared_ptr<ShaderBuffer> pBuffer; /**< created on first upload, when the OpenGL context is guaranteed to exist */
+  size_t pSize = 0;                      /**< number of edges in the buffer */
+};
+
+/*!
+ * \brief EdgeLists holds the uploaded edge sets of the approximation results
+ */
+struct EdgeLists {
+  EdgeList BTSP_BICONNECTED_GRAPH;
+  EdgeList BTSP_OPEN_EAR_DECOMPOSITION;
+  EdgeList BTSPP_BICONNECTED_GRAPH;
+  EdgeList BTSVPP_BICONNECTED_GRAPH;
 };
 
 struct Results {
@@ -93,6 +223,71 @@ struct Appearance {
   }
 };
 
+/*!
+ * \brief AppearanceBlock mirrors the std140 layout of the uniform block appearanceBlock in the shaders
+ */
+struct AppearanceBlock {
+  struct TypeAppearance {
+    RGBA_COLOUR colour;
+    float thickness;
+    std::array<float, 3> padding; /**< std140 rounds the size of structs in arrays up to a multiple of 16 bytes */
+
+    bool operator==(const TypeAppearance&) const = default;
+  };
+
+  std::array<TypeAppearance, std::to_underlying(ProblemType::NUMBER_OF_OPTIONS)> type;
+  std::array<float, 2> resolution;
+  std::array<float, 2> cameraCenter;
+  float zoom;
+  std::array<float, 3> padding;
+
+  bool operator==(const AppearanceBlock&) const = default;
+};
+
+static_assert(sizeof(AppearanceBlock::TypeAppearance) == 32, "TypeAppearance doesn't match std140 layout");
+static_assert(offsetof(AppearanceBlock, zoom) == 208, "AppearanceBlock doesn't match std140 layout");
+static_assert(std::to_underlying(ProblemType::NUMBER_OF_OPTIONS) == 6, "size of u_appearance in the shaders needs to be adjusted");
+
+/*!
+ * \brief AppearanceUniforms keeps the per problem type colour and thickness, the resolution and the camera in a
+ * uniform buffer
+ * \details The buffer is only written when the appearance, the window size or the camera differs from what was
+ * uploaded last.
+ */
+class AppearanceUniforms {
+public:
+  /*!
+   * \brief uploads appearance, resolution and camera if they changed since the last call, binds the buffer on first use
+   * \param appearance current appearance
+   * \param width window width
+   * \param height window height
+   * \param camera current camera
+   */
+  void update(const Appearance& appearance, const float width, const float height, const Camera& camera) {
+    AppearanceBlock block{};
+    for (size_t i = 0; i < block.type.size(); ++i) {
+      block.type[i].colour    = appearance.colour[i];
+      block.type[i].thickness = appearance.thickness[i];
+    }
+    block.resolution   = {width, height};
+    block.cameraCenter = {static_cast<float>(camera.center.x), static_cast<float>(camera.center.y)};
+    block.zoom         = static_cast<float>(camera.zoom);
+    if (pBuffer && block == pUploaded) {
+      return;
+    }
+    if (!pBuffer) {
+      pBuffer = std::make_shared<UniformBuffer>();
+      pBuffer->bindBase(APPEARANCE_BINDING_POINT);
+    }
+    pBuffer->bufferData(block);
+    pUploaded = block;
+  }
+
+private:
+  std::shared_ptr<UniformBuffer> pBuffer; /**< created on first upload, when the OpenGL context is guaranteed to exist */
+  AppearanceBlock pUploaded;              /**< content of the buffer */
+};
+
 class VertexOrder {
 public:
   VertexOrder() : pInitialized(INITIAL_ACTIVENESS) {}
@@ -114,6 +309,10 @@ struct DrawData {
   const Buffers buffers;
   FloatVertices floatVertices;
   Results results;
+  EdgeLists edgeLists;
+  std::array<std::vector<size_t>, std::to_underlying(ProblemType::NUMBER_OF_OPTIONS)> fullTours; /**< tours as solved */
+  LevelOfDetail levelOfDetail;
+  AppearanceUniforms appearanceUniforms;
   VertexOrder vertexOrder;
   Appearance appearance;
 };
@@ -27,10 +27,22 @@
 
 #include "draw/buffers.hpp"
 #include "draw/drawdata.hpp"
+#include "draw/solverworker.hpp"
 #include "draw/variables.hpp"
 
+/*!
+ * \brief requestRedraw makes the main loop draw the next REDRAW_FRAMES frames instead of waiting for events
+ */
+void requestRedraw();
+
 void keyCallback([[maybe_unused]] GLFWwindow* window, int key, [[maybe_unused]] int scancode, int action, [[maybe_unused]] int mods);
 
 void mouseButtonCallback([[maybe_unused]] GLFWwindow* window, int button, int action, [[maybe_unused]] int mods);
 
-void handleEvents(GLFWwindow* window, std::shared_ptr<drawing::DrawData> drawData);
+void scrollCallback(GLFWwindow* window, [[maybe_unused]] double xoffset, double yoffset);
+
+void cursorPositionCallback([[maybe_unused]] GLFWwindow* window, [[maybe_unused]] double x, [[maybe_unused]] double y);
+
+void framebufferSizeCallback([[maybe_unused]] GLFWwindow* window, [[maybe_unused]] int width, [[maybe_unused]] int height);
+
+void handleEvents(GLFWwindow* window, std::shared_ptr<drawing::DrawData> drawData, drawing::SolverWorker& worker);
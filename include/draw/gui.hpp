@@ -22,6 +22,7 @@
 #include <GLFW/glfw3.h>
 
 #include "draw/drawdata.hpp"
+#include "draw/solverworker.hpp"
 
 /*!
  * \brief imguiVersionHints sets version of opengl
@@ -39,8 +40,10 @@ void setUpImgui(GLFWwindow* window, const char* glsl_version);
 
 /*!
  * \brief drawImgui draws the updated gui for every frame
+ * \param appearance colours and thicknesses editable in the settings window
+ * \param worker background solver, queried for the types that are being computed
  */
-void drawImgui(drawing::Appearance& appearance);
+void drawImgui(drawing::Appearance& appearance, const drawing::SolverWorker& worker);
 
 /*!
  * \brief cleanUpImgui frees memory for gui and performs proper shutdown of windows
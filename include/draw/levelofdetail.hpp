@@ -0,0 +1,83 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// graph library
+#include "geometry.hpp"
+
+#include "draw/camera.hpp"
+
+/*! \file levelofdetail.hpp */
+
+namespace drawing {
+constexpr size_t LOD_VERTEX_THRESHOLD = 20000;  // more visible vertices than this switch to the reduced level of detail
+constexpr int LOD_TILE_PIXELS         = 4;      // edge length of a density tile in pixels
+constexpr double LOD_PIXEL_TOLERANCE  = 2.0;    // tour vertices closer than this to their predecessor are dropped
+
+/*!
+ * \brief LevelOfDetail reduces what is drawn when many vertices are visible at once
+ * \details The window is divided into square tiles of LOD_TILE_PIXELS pixels, each non empty tile is drawn by a single
+ * representative vertex. Tours are simplified by dropping vertices that are less than LOD_PIXEL_TOLERANCE pixels away
+ * from the last kept vertex. When zooming in until at most LOD_VERTEX_THRESHOLD vertices are visible, everything is
+ * drawn in full detail again.
+ */
+class LevelOfDetail {
+public:
+  /*!
+   * \brief recomputes the representatives if the view or the positions changed
+   * \param points positions of the vertices
+   * \param camera current camera
+   * \param width window width in pixels
+   * \param height window height in pixels
+   * \param positionsChanged true if a vertex has been moved since the last call
+   * \return true if something has been recomputed
+   */
+  bool update(const std::vector<graph::Point2D>& points, const Camera& camera, const int width, const int height, const bool positionsChanged);
+
+  /*!
+   * \brief true if the reduced level of detail is in use
+   */
+  bool active() const { return pActive; }
+
+  /*!
+   * \brief one vertex per non empty density tile, only meaningful if active()
+   */
+  const std::vector<uint32_t>& representatives() const { return pRepresentatives; }
+
+  /*!
+   * \brief drops tour vertices that are too close to their predecessor on screen, the first and last vertex are kept
+   * \param tour sequence of vertices, a cycle or a path
+   * \param points positions of the vertices
+   * \return simplified tour, or tour itself if simplification would leave too few vertices to draw
+   */
+  std::vector<size_t> simplify(const std::vector<size_t>& tour, const std::vector<graph::Point2D>& points) const;
+
+private:
+  Camera pCamera;
+  int pWidth   = 0;
+  int pHeight  = 0;
+  bool pValid  = false;
+  bool pActive = false;
+  std::vector<uint32_t> pRepresentatives;
+};
+}  // namespace drawing
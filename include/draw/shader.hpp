@@ -19,12 +19,25 @@
 #pragma once
 
 #include <array>
+#include <cassert>
+#include <string>
+#include <unordered_map>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
 #include "draw/openglerrors.hpp"
 
+/*!
+ * \brief Uniform is a typed handle to the location of an active uniform
+ * \details GLType is the uniform's OpenGL type, e.g. GL_FLOAT or GL_FLOAT_VEC2, so that setUniform() overloads can only
+ * be called with matching values.
+ */
+template <GLenum GLType>
+struct Uniform {
+  GLint location;
+};
+
 class ShaderProgram {
 public:
   ShaderProgram() : pProgramID(glCreateProgram()) {}
@@ -34,18 +47,45 @@ public:
 
   void attachShader(const GLuint shader) const { GL_CALL(glAttachShader(pProgramID, shader);) }
 
-  void link() const;
+  /*!
+   * \brief links the program and caches the locations of all active uniforms outside of uniform blocks
+   */
+  void link();
+
+  /*!
+   * \brief returns the cached location of the active uniform name
+   * \details asserts that the uniform exists and is of type GLType
+   */
+  template <GLenum GLType>
+  Uniform<GLType> uniform(const char* name) const {
+    const auto it = pUniforms.find(name);
+    assert(it != pUniforms.end() && "could not find uniform");
+    assert(it->second.type == GLType && "uniform has a different type");
+    return Uniform<GLType>{it->second.location};
+  }
 
-  void setUniform(const char* name, const float value) const;
-  void setUniform(const char* name, const int value) const;
-  void setUniform(const char* name, const float val1, const float val2) const;
-  void setUniform(const char* name, const float val1, const float val2, const float val3, const float val4) const;
-  void setUniform(const char* name, const std::array<float, 4>& value) const;
+  void setUniform(const Uniform<GL_FLOAT> uniform, const float value) const { GL_CALL(glUniform1f(uniform.location, value);) }
+  void setUniform(const Uniform<GL_INT> uniform, const int value) const { GL_CALL(glUniform1i(uniform.location, value);) }
+  void setUniform(const Uniform<GL_FLOAT_VEC2> uniform, const float val1, const float val2) const {
+    GL_CALL(glUniform2f(uniform.location, val1, val2);)
+  }
+  void setUniform(const Uniform<GL_FLOAT_VEC4> uniform, const float val1, const float val2, const float val3, const float val4) const {
+    GL_CALL(glUniform4f(uniform.location, val1, val2, val3, val4);)
+  }
+  void setUniform(const Uniform<GL_FLOAT_VEC4> uniform, const std::array<float, 4>& value) const {
+    GL_CALL(glUniform4f(uniform.location, value[0], value[1], value[2], value[3]);)
+  }
 
   void use() const { GL_CALL(glUseProgram(pProgramID);) }
 
 private:
+  struct UniformInfo {
+    GLint location;
+    GLenum type;
+  };
+
   const GLuint pProgramID;
+  std::unordered_map<std::string, UniformInfo> pUniforms; /**< active uniforms by name, filled by link() */
 };
 
 class ShaderCollection {
@@ -56,6 +96,7 @@ public:
   ShaderProgram linkCircleDrawProgram() const;
   ShaderProgram linkPathSegementDrawProgram() const;
   ShaderProgram linkLineDrawProgram() const;
+  ShaderProgram linkEdgeDrawProgram() const;
 
 private:
   const GLuint pVertexShader;
@@ -63,14 +104,42 @@ private:
   const GLuint pPathVertexShader;
   const GLuint pFragmentShader;
   const GLuint pLineVertexShader;
+  const GLuint pEdgeVertexShader;
+  const GLuint pColouredFragmentShader;
 };
 
+/*!
+ * \brief ShaderProgramCollection holds the linked draw programs together with the handles of their uniforms
+ * \details the handles are resolved once on construction, so drawing a frame does not look up uniforms by name
+ */
 struct ShaderProgramCollection {
-  ShaderProgramCollection(const ShaderProgram& drawCircles, const ShaderProgram& drawPathSegments, const ShaderProgram& drawLine) :
+  ShaderProgramCollection(const ShaderProgram& drawCircles,
+                          const ShaderProgram& drawPathSegments,
+                          const ShaderProgram& drawLine,
+                          const ShaderProgram& drawEdges) :
     drawCircles(drawCircles),
     drawPathSegments(drawPathSegments),
-    drawLine(drawLine) {}
+    drawLine(drawLine),
+    drawEdges(drawEdges),
+    circleSteps(drawCircles.uniform<GL_INT>("u_steps")),
+    circleRadius(drawCircles.uniform<GL_FLOAT>("u_radius")),
+    circleColour(drawCircles.uniform<GL_FLOAT_VEC4>("u_colour")),
+    pathSegmentType(drawPathSegments.uniform<GL_INT>("u_type")),
+    lineEnds(drawLine.uniform<GL_FLOAT_VEC4>("u_ends")),
+    lineType(drawLine.uniform<GL_INT>("u_type")),
+    lineThicknessFactor(drawLine.uniform<GL_FLOAT>("u_thicknessFactor")),
+    edgeType(drawEdges.uniform<GL_INT>("u_type")) {}
   const ShaderProgram drawCircles;
   const ShaderProgram drawPathSegments;
   const ShaderProgram drawLine;
+  const ShaderProgram drawEdges; /**< draws all edges of an EdgeList with one instanced draw call */
+
+  const Uniform<GL_INT> circleSteps;
+  const Uniform<GL_FLOAT> circleRadius;
+  const Uniform<GL_FLOAT_VEC4> circleColour;
+  const Uniform<GL_INT> pathSegmentType;
+  const Uniform<GL_FLOAT_VEC4> lineEnds;
+  const Uniform<GL_INT> lineType;
+  const Uniform<GL_FLOAT> lineThicknessFactor;
+  const Uniform<GL_INT> edgeType;
 };
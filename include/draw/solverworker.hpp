@@ -0,0 +1,144 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+// graph library
+#include "graph.hpp"
+
+#include "solve/approximation.hpp"
+#include "solve/definitions.hpp"
+#include "solve/exactsolver.hpp"
+
+/*! \file solverworker.hpp */
+
+namespace drawing {
+
+/*!
+ * \brief SolverOutput is a finished job, handed from a worker thread to the render thread
+ */
+struct SolverOutput {
+  ProblemType type;                                                /**< type of the solved instance */
+  uint64_t generation;                                             /**< generation of the job */
+  std::variant<approximation::Result, exactsolver::Result> result; /**< approximation result or exact result */
+  std::string error;                                               /**< message of a failed job, result is unset then */
+
+  bool failed() const { return !error.empty(); }
+};
+
+/*!
+ * \brief SolverWorker solves instances on background threads, so that the render loop keeps running
+ * \details Jobs are queued and taken by a small pool of threads, so that jobs for different problem types run in
+ * parallel. Each problem type has a generation counter, submitting or cancelling bumps it and every job whose
+ * generation is outdated is dropped before it starts and its result is discarded when it finishes. Finished results
+ * are published per type through an atomic shared pointer, the render thread takes them with collect(). A job that
+ * throws is published as a failed output carrying the message.
+ */
+class SolverWorker {
+public:
+  /*!
+   * \brief constructor, starts the worker threads
+   * \param numberOfThreads number of jobs that can run at the same time
+   */
+  SolverWorker(const unsigned int numberOfThreads = defaultNumberOfThreads());
+
+  /*!
+   * \brief destructor, cancels queued jobs, interrupts running HiGHS solves and waits for the threads
+   */
+  ~SolverWorker();
+
+  SolverWorker(const SolverWorker&)            = delete;
+  SolverWorker& operator=(const SolverWorker&) = delete;
+
+  /*!
+   * \brief queues a job for type and supersedes all older jobs of the same type
+   * \param euclidean snapshot of the graph, shared between the jobs of one submission
+   * \param type problem type to solve
+   * \param noCrossing forbid crossings, only used by the exact solver
+   * \param silent don't print the result to the terminal
+   */
+  void submit(const std::shared_ptr<const graph::Euclidean> euclidean,
+              const ProblemType type,
+              const bool noCrossing,
+              const bool silent = false);
+
+  /*!
+   * \brief drops queued jobs of type and discards the result of a running one
+   * \details A running HiGHS solve is interrupted, approximations and the dynamic program run to the end.
+   * \param type problem type
+   */
+  void cancel(const ProblemType type);
+
+  /*!
+   * \brief calls cancel() for every problem type
+   */
+  void cancelAll();
+
+  /*!
+   * \brief checks if a job of type is queued or running and hasn't been superseded
+   * \param type problem type
+   */
+  bool computing(const ProblemType type) const { return pPending[std::to_underlying(type)].load() != 0; }
+
+  /*!
+   * \brief takes the latest finished result of type
+   * \param type problem type
+   * \return the result or nullptr if there is no new result
+   */
+  std::shared_ptr<const SolverOutput> collect(const ProblemType type);
+
+private:
+  struct Job {
+    std::shared_ptr<const graph::Euclidean> euclidean;
+    ProblemType type;
+    uint64_t generation;
+    bool noCrossing;
+    bool silent;
+  };
+
+  static unsigned int defaultNumberOfThreads();
+
+  void run();
+  void execute(const Job& job);
+  bool current(const Job& job) const { return pGeneration[std::to_underlying(job.type)].load() == job.generation; }
+
+  static constexpr size_t NUMBER_OF_TYPES = std::to_underlying(ProblemType::NUMBER_OF_OPTIONS);
+
+  std::array<std::atomic<uint64_t>, NUMBER_OF_TYPES> pGeneration{}; /**< generation of the latest submission or cancel */
+  std::array<std::atomic<uint64_t>, NUMBER_OF_TYPES> pPending{};    /**< generation of the job in progress, 0 if none */
+  std::array<std::atomic<std::shared_ptr<const SolverOutput>>, NUMBER_OF_TYPES> pFinished; /**< lock free handoff */
+
+  std::mutex pQueueMutex;
+  std::condition_variable pQueueCondition;
+  std::deque<Job> pQueue;
+  bool pStop = false;
+  std::vector<std::thread> pThreads;
+};
+}  // namespace drawing
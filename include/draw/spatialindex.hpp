@@ -0,0 +1,74 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// graph library
+#include "geometry.hpp"
+
+/*! \file spatialindex.hpp */
+
+namespace drawing {
+
+/*!
+ * \brief UniformGrid buckets vertices into square cells to find vertices near a point without scanning all of them
+ * \details The grid covers [-1, 1] x [-1, 1], the visible part of the window. Points outside are put into the nearest
+ * border cell, so they are still found, only with more candidates per cell. As long as the cell size is at least the
+ * query radius, a query only needs to look at the 3 x 3 cells around the query point.
+ */
+class UniformGrid {
+public:
+  UniformGrid() = default;
+
+  /*!
+   * \brief constructs the grid and inserts all points
+   * \param points positions of the vertices, the index in the vector is the vertex
+   * \param cellSize edge length of a cell, should not be smaller than the radius of queries
+   */
+  UniformGrid(const std::vector<graph::Point2D>& points, const double cellSize);
+
+  /*!
+   * \brief moves vertex u from position from to position to
+   * \param u vertex
+   * \param from old position of u, as inserted
+   * \param to new position of u
+   */
+  void move(const size_t u, const graph::Point2D& from, const graph::Point2D& to);
+
+  /*!
+   * \brief finds the vertex closest to point
+   * \param points positions of the vertices, the same positions the grid was built and updated with
+   * \param point query point
+   * \param radius only vertices with distance less than radius are considered
+   * \return closest vertex or namedInts::INVALID if there is no vertex within radius
+   */
+  int nearest(const std::vector<graph::Point2D>& points, const graph::Point2D& point, const double radius) const;
+
+private:
+  size_t column(const double x) const;
+  size_t row(const double y) const;
+  size_t cell(const graph::Point2D& point) const { return row(point.y) * pCellsPerSide + column(point.x); }
+
+  double pCellSize     = 1.0;
+  size_t pCellsPerSide = 0;
+  std::vector<std::vector<size_t>> pCells; /**< vertices per cell, row major */
+};
+}  // namespace drawing
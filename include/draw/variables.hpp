@@ -28,13 +28,17 @@
 #include "geometry.hpp"
 #include "graph.hpp"
 
+#include "draw/camera.hpp"
 #include "draw/definitions.hpp"
+#include "draw/spatialindex.hpp"
 
 #include "solve/approximation.hpp"
 #include "solve/exactsolver.hpp"
 
 namespace drawing {
 extern graph::Euclidean EUCLIDEAN;
+extern UniformGrid VERTEX_GRID;  // kept in sync with the positions in EUCLIDEAN
+extern Camera CAMERA;
 
 extern bool SHOW_DEBUG_WINDOW;
 extern bool SHOW_SETTINGS_WINDOW;
@@ -49,6 +53,8 @@ extern bool BTSPP_DRAW_BICONNECTED_GRAPH;
 extern bool BTSPP_DRAW_HAMILTON_PATH;
 extern bool BTSVPP_DRAW_BICONNECTED_GRAPH;
 extern bool BTSVPP_DRAW_HAMILTON_PATH;
+
+extern bool LIVE_APPROXIMATION;
 }  // namespace drawing
 
 namespace input {
@@ -57,12 +63,15 @@ extern std::unordered_map<int, bool> STATE;
 namespace mouse {
 extern graph::Point2D MOUSE_LEFT_CLICKED;
 extern int NODE_IN_MOTION;
+extern int NODE_HOVERED;
+extern graph::Point2D LAST_CURSOR_POSITION;  // in normalized device coordinates, used for panning
 }  // namespace mouse
 }  // namespace input
 
 namespace mainwindow {
 extern int HEIGHT;
 extern int WIDTH;
+extern unsigned int FRAMES_TO_DRAW;  // the main loop waits for events when this is 0
 }  // namespace mainwindow
 
 namespace solve {
@@ -50,3 +50,8 @@ class UnknownType : public Exception {
 public:
   UnknownType(const std::string& msg) : Exception(msg) {}
 };
+
+class Interrupted : public Exception {
+public:
+  Interrupted(const std::string& msg) : Exception(msg) {}
+};
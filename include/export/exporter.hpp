@@ -0,0 +1,88 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*! \file exporter.hpp
+ * Background export of solution images for batch runs.
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "export/rasteriser.hpp"
+
+namespace imageexport {
+
+/*!
+ * @brief Exporter renders solutions to PNG files on a thread of its own, so that the solver loop never waits for it
+ * @details At most MAX_QUEUED_IMAGES solutions are queued, submit() blocks while the queue is full, so that a slow disk
+ * can't let the copied solutions pile up in memory. The destructor waits until every queued image is written. Failing
+ * to write an image is reported as a warning on std::cerr and doesn't stop the export of the other images.
+ */
+class Exporter {
+public:
+  static constexpr size_t MAX_QUEUED_IMAGES = 4; /**< solutions waiting to be rendered before submit() blocks */
+
+  /*!
+   * @brief constructor, creates directory if it doesn't exist and starts the export thread
+   * @param directory directory to write the images to
+   * @param width width of the images in pixels
+   * @param height height of the images in pixels
+   */
+  Exporter(const std::string& directory, const unsigned int width, const unsigned int height);
+
+  /*!
+   * @brief destructor, waits until all queued images are written
+   */
+  ~Exporter();
+
+  Exporter(const Exporter&)            = delete;
+  Exporter& operator=(const Exporter&) = delete;
+
+  /*!
+   * @brief queues a solution to be rendered, waits while MAX_QUEUED_IMAGES solutions are queued
+   * @param solution solved instance, moved into the queue
+   * @param name filename of the image relative to the export directory
+   */
+  void submit(Solution&& solution, const std::string& name);
+
+private:
+  struct Job {
+    Solution solution;
+    std::string filename;
+  };
+
+  void run();
+
+  std::string pDirectory;
+  unsigned int pWidth;
+  unsigned int pHeight;
+
+  std::mutex pQueueMutex;
+  std::condition_variable pQueueCondition; /**< signals the export thread that a job was queued or it has to stop */
+  std::condition_variable pSpaceCondition; /**< signals submit() that a job was taken from the queue */
+  std::deque<Job> pQueue;
+  bool pStop = false;
+  std::thread pThread;
+};
+}  // namespace imageexport
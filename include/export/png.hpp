@@ -0,0 +1,38 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*! \file png.hpp
+ * Minimal PNG encoder. The image data is compressed with fixed Huffman codes and run length matches against the
+ * previous pixel and the previous row, which is enough for the large uniform areas of rendered solutions.
+ */
+
+#include <string>
+
+#include "export/rasteriser.hpp"
+
+namespace imageexport {
+
+/*!
+ * @brief writes image to a PNG file
+ * @param filename name of the file, an existing file is overwritten
+ * @param image image to write
+ */
+void writePng(const std::string& filename, const Image& image);
+}  // namespace imageexport
@@ -0,0 +1,64 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*! \file rasteriser.hpp
+ * CPU rasteriser for solution images. It draws the same primitives as the path and vertex shaders of the interactive
+ * window with the initial appearance from draw/definitions.hpp, so that it runs without any display or OpenGL context.
+ */
+
+#include <cstdint>
+#include <vector>
+
+// graph library
+#include "graph.hpp"
+
+#include "solve/definitions.hpp"
+
+namespace imageexport {
+
+/*!
+ * @brief Image is an 8 bit RGB image, the rows are stored from top to bottom
+ */
+struct Image {
+  unsigned int width  = 0;      /**< number of pixels per row */
+  unsigned int height = 0;      /**< number of rows */
+  std::vector<uint8_t> pixels;  /**< width * height * 3 bytes */
+};
+
+/*!
+ * @brief Solution bundles everything needed to render one solved instance
+ */
+struct Solution {
+  std::vector<graph::Point2D> positions; /**< positions of the vertices */
+  std::vector<size_t> tour;              /**< order of the vertices, closed for cycle types */
+  graph::Edge bottleneckEdge;            /**< edge drawn thicker */
+  ProblemType type;                      /**< problem type, selects colour, thickness and whether the tour is closed */
+};
+
+/*!
+ * @brief renders the tour, the bottleneck edge and the vertices of a solution
+ * @details The positions are fitted into the image keeping the aspect ratio.
+ * @param solution solved instance
+ * @param width width of the image in pixels
+ * @param height height of the image in pixels
+ * @return rendered image
+ */
+Image render(const Solution& solution, const unsigned int width, const unsigned int height);
+}  // namespace imageexport
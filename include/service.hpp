@@ -0,0 +1,46 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "solve/definitions.hpp"
+
+namespace service {
+/*!
+ * @brief encoding of the point sets read from stdin
+ * @details Text: the number of nodes followed by x and y of every node, separated by whitespace.
+ * Binary: the number of nodes as uint64_t followed by x and y of every node as double, both in host byte order.
+ */
+enum class Format { Text, Binary };
+
+/*!
+ * @brief reads point sets from stdin until end of file and writes a solution for every problem type to stdout
+ * @details For every instance and problem type one line <type> <objective> <node_0> ... <node_n-1> is written. The next
+ * instance is read on another thread while the current one is solved. If a problem type fails or an instance is skipped,
+ * because it is too small or exceeds the memory budget, the line error <type> <message> is written instead and serving
+ * continues. Malformed input ends the service with InvalidFileOperation, since the position of the next instance is lost.
+ * @param types problem types to solve for every instance
+ * @param format encoding of the input
+ * @param noCrossing forbid crossings in exact BTSP solutions
+ * @param memoryBudget memory available for one instance in bytes, 0 if unlimited, larger instances are skipped
+ */
+void serve(const std::vector<ProblemType>& types, const Format format, const bool noCrossing = false, const size_t memoryBudget = 0);
+}  // namespace service
@@ -19,29 +19,94 @@
 #pragma once
 
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 // graph library
 #include "algorithm.hpp"
 #include "graph.hpp"
 
+#include "solve/chaindecomposition.hpp"
 #include "solve/commonfunctions.hpp"
 #include "solve/definitions.hpp"
 
+#include "utility/perfcounter.hpp"
+
 namespace approximation {
+/*!
+ * @brief ResultPolicy selects which intermediate graphs are retained in the Result
+ * @details Full moves the biconnected graph and the open ear decomposition into the result, the visualisation draws
+ * them. Compact leaves both empty, so that a result only holds the tour and the measures, as batch runs need.
+ */
+enum class ResultPolicy {
+  Full,
+  Compact
+};
+
+/*!
+ * @brief true if the weights of G satisfy the triangle inequality, only then the approximations are within factor 2
+ * @details Graphs declare it with a static constexpr bool METRIC, graph::Euclidean is metric, all other graphs are not.
+ */
+template <typename G>
+constexpr bool satisfiesTriangleInequality() {
+  if constexpr (requires { G::METRIC; }) {
+    return G::METRIC;
+  }
+  else {
+    return std::is_base_of_v<graph::Euclidean, G>;
+  }
+}
+
 /*!
  * @brief Result bundles all important measures from the approximation
  */
 struct Result {
-  graph::AdjacencyListGraph biconnectedGraph;     /**< bottleneck optimal biconnected subgraph */
-  graph::EarDecomposition openEarDecomposition;   /**< open ear decomposition */
+  graph::AdjacencyListGraph biconnectedGraph;     /**< bottleneck optimal biconnected subgraph, empty if compact */
+  graph::EarDecomposition openEarDecomposition;   /**< open ear decomposition, empty if compact */
   std::vector<size_t> tour;                       /**< hamilton cycle in square of original graph */
   graph::Edge bottleneckEdge;                     /**< a longest edge in the tour */
   double objective;                               /**< length of the longest edge */
   double lowerBoundOnOPT;                         /**< lower bound on opt */
+  size_t numberOfEdgesInBiconnectedGraph;         /**< number of edges in the biconnected subgraph */
   size_t numberOfEdgesInMinimallyBiconectedGraph; /**< number of edges in th minimally biconnected subgraph */
 };
 
+/*!
+ * @brief assembles the result and retains the intermediate graphs according to Policy
+ * @tparam Policy decides if biconnectedGraph and openEars are moved into the result or dropped
+ */
+template <ResultPolicy Policy>
+Result makeResult(graph::AdjacencyListGraph&& biconnectedGraph,
+                  graph::EarDecomposition&& openEars,
+                  std::vector<size_t>&& tour,
+                  const graph::Edge& bottleneckEdge,
+                  const double objective,
+                  const double lowerBoundOnOPT,
+                  const size_t numberOfEdgesInMinimallyBiconectedGraph) {
+  const size_t numberOfEdgesInBiconnectedGraph = biconnectedGraph.numberOfEdges();
+  if constexpr (Policy == ResultPolicy::Full) {
+    return Result{std::move(biconnectedGraph),
+                  std::move(openEars),
+                  std::move(tour),
+                  bottleneckEdge,
+                  objective,
+                  lowerBoundOnOPT,
+                  numberOfEdgesInBiconnectedGraph,
+                  numberOfEdgesInMinimallyBiconectedGraph};
+  }
+  else {
+    return Result{{},
+                  {},
+                  std::move(tour),
+                  bottleneckEdge,
+                  objective,
+                  lowerBoundOnOPT,
+                  numberOfEdgesInBiconnectedGraph,
+                  numberOfEdgesInMinimallyBiconectedGraph};
+  }
+}
+
 /*!
  * @brief lists all important information from solving in the terminal
  * @param res result
@@ -50,20 +115,50 @@ struct Result {
  */
 void printInfo(const approximation::Result& res, const ProblemType problemType, const double runtime = -1.0);
 
+/*! bytes of one candidate edge of the complete graph in the estimate, the edge and its weight */
+constexpr size_t BYTES_PER_CANDIDATE_EDGE = sizeof(graph::Edge) + sizeof(double);
+
 /*!
- * @brief remove all edges whcih are not 2-essential
+ * @brief estimates the peak memory needed to approximate an instance without building any graph
+ * @details The estimate is dominated by the candidate edges of the complete graph, which are considered by the bottleneck
+ * optimal biconnected subgraph, and the adjacency lists of the graphs built afterwards.
+ * @param numberOfNodes number of nodes in the complete graph
+ * @param problemType type of instance
+ * @return estimated peak memory in bytes
+ */
+size_t estimateMemory(const size_t numberOfNodes, const ProblemType problemType);
+
+/*!
+ * @brief MinimallyBiconnected bundles a minimally biconnected graph with an open ear decomposition of it
+ */
+struct MinimallyBiconnected {
+  graph::AdjacencyListGraph graph;  /**< minimally biconnected graph */
+  graph::EarDecomposition openEars; /**< open ear decomposition of graph */
+};
+
+/*!
+ * @brief remove all edges whcih are not 2-essential and decompose the result into open ears
  * @details The ear decomposition is computed to cheaply get rid of many edges at once. The removal has roughly the same computaional costs
- * as every check (using schmidt algorithm) for biconnectivity after removal of a single edge.
+ * as every check (using schmidt algorithm) for biconnectivity after removal of a single edge. The non trivial ears of the first
+ * decomposition are an open ear decomposition of the graph they span. If no further edge is removed from that graph, they are reused
+ * and the second chain decomposition is skipped.
  * @tparam G type of graph
  * @param biconnectedGraph a biconnected graph as input
- * @return AdjacencyListGraph: minimally biconnected graph
+ * @return MinimallyBiconnected: minimally biconnected graph and its open ear decomposition
  */
 template <typename G>
   requires(std::is_base_of_v<graph::Graph, G>)
-static graph::AdjacencyListGraph makeMinimallyBiconnected(const G& biconnectedGraph) {
-  const graph::EarDecomposition ears       = schmidt(biconnectedGraph);
+static MinimallyBiconnected makeMinimallyBiconnected(const G& biconnectedGraph) {
+  graph::EarDecomposition ears = chainDecomposition(biconnectedGraph);
+  removeTrivialEars(ears);
   const graph::AdjacencyListGraph fromEars = earDecompToAdjacencyListGraph(ears, biconnectedGraph.numberOfNodes());
-  return minimallyBiconnectedSubgraph(fromEars);
+  graph::AdjacencyListGraph minimal        = minimallyBiconnectedSubgraph(fromEars);
+  if (minimal.numberOfEdges() == fromEars.numberOfEdges()) {
+    return MinimallyBiconnected{std::move(minimal), std::move(ears)};
+  }
+  const perfcounter::Scope scope("schmidt");
+  graph::EarDecomposition openEars = chainDecomposition(minimal);  // calculate proper ear decomposition
+  return MinimallyBiconnected{std::move(minimal), std::move(openEars)};
 }
 
 /*!
@@ -76,22 +171,34 @@ std::vector<size_t> findHamiltonCycleInOpenEarDecomposition(const graph::EarDeco
 
 /*!
  * @brief approximates a BTSP
+ * @tparam Policy decides which intermediate graphs are retained in the result
  * @tparam G type of graph, must be complete and weighted
  * @param completeGraph complete weighted graph, providing distances between nodes
  * @return Result
  */
-template <typename G>
+template <ResultPolicy Policy = ResultPolicy::Full, typename G>
   requires(std::is_base_of_v<graph::CompleteGraph, G> && std::is_base_of_v<graph::WeightedGraph, G>)
 Result approximateBTSP(const G& completeGraph) {
-  const auto [biconnectedGraph, maxEdgeWeight] = bottleneckOptimalBiconnectedSubgraph(completeGraph);
-  const graph::AdjacencyListGraph minimal      = makeMinimallyBiconnected(biconnectedGraph);
-  const graph::EarDecomposition openEars       = schmidt(minimal);  // calculate proper ear decomposition
-  const std::vector<size_t> tour               = findHamiltonCycleInOpenEarDecomposition(openEars, completeGraph.numberOfNodes());
-  const graph::Edge bottleneckEdge             = findBottleneck(completeGraph, tour, true);
-  const double objective                       = completeGraph.weight(bottleneckEdge);
-
-  assert(objective / maxEdgeWeight <= 2 && objective / maxEdgeWeight >= 1 && "A fortiori guarantee is nonsense!");
-  return Result{biconnectedGraph, openEars, tour, bottleneckEdge, objective, maxEdgeWeight, minimal.numberOfEdges()};
+  perfcounter::Scope scope("biconnected subgraph");
+  auto [biconnectedGraph, maxEdgeWeight] = bottleneckOptimalBiconnectedSubgraph(completeGraph);
+  scope.next("minimally biconnected");
+  auto [minimal, openEars] = makeMinimallyBiconnected(biconnectedGraph);
+  scope.next("hamilton cycle");
+  std::vector<size_t> tour = findHamiltonCycleInOpenEarDecomposition(openEars, completeGraph.numberOfNodes());
+  scope.next("bottleneck");
+  const graph::Edge bottleneckEdge = findBottleneck(completeGraph, tour, true);
+  const double objective           = completeGraph.weight(bottleneckEdge);
+  scope.stop();
+
+  assert(objective >= maxEdgeWeight && "A fortiori guarantee is nonsense!");
+  assert((!satisfiesTriangleInequality<G>() || objective <= 2 * maxEdgeWeight) && "A fortiori guarantee is nonsense!");
+  return makeResult<Policy>(std::move(biconnectedGraph),
+                            std::move(openEars),
+                            std::move(tour),
+                            bottleneckEdge,
+                            objective,
+                            maxEdgeWeight,
+                            minimal.numberOfEdges());
 }
 
 /*!
@@ -115,7 +222,7 @@ template <typename G>
   requires(std::is_base_of_v<graph::Graph, G>)
 graph::AdjacencyListGraph makeEdgeAugmentedMinimallyBiconnected(const G& biconnectedGraph, const size_t s, const size_t t) {
   const graph::Edge st_Edge{s, t};
-  const graph::EarDecomposition ears = schmidt(biconnectedGraph);
+  const graph::EarDecomposition ears = chainDecomposition(biconnectedGraph);
   graph::AdjacencyListGraph fromEars = earDecompToAdjacencyListGraph(ears, biconnectedGraph.numberOfNodes());
   if (!fromEars.adjacent(s, t)) {  // if the s-t edge is one of the removed ones,
     fromEars.addEdge(st_Edge);     // add it again.
@@ -138,6 +245,7 @@ graph::AdjacencyListGraph createFiveFoldGraph(const graph::AdjacencyListGraph& m
 
 /*!
  * @brief approximates a BTSPP
+ * @tparam Policy decides which intermediate graphs are retained in the result
  * @tparam G type of complete graph
  * @param completeGraph complete weighted graph provinding the distances between nodes
  * @param biconnectedGraph
@@ -146,59 +254,78 @@ graph::AdjacencyListGraph createFiveFoldGraph(const graph::AdjacencyListGraph& m
  * @param t end node
  * @return Result
  */
-template <typename G>
+template <ResultPolicy Policy, typename G>
   requires(std::is_base_of_v<graph::CompleteGraph, G> && std::is_base_of_v<graph::WeightedGraph, G>)
 Result findHamiltonPathInBottleneckOptimalBiconnectedSubgraph(const G& completeGraph,
-                                                              const graph::AdjacencyListGraph& biconnectedGraph,
+                                                              graph::AdjacencyListGraph biconnectedGraph,
                                                               const double maxEdgeWeight,
                                                               const size_t s,
                                                               const size_t t) {
+  perfcounter::Scope scope("minimally biconnected");
   const graph::AdjacencyListGraph minimal = makeEdgeAugmentedMinimallyBiconnected(biconnectedGraph, s, t);
+  scope.next("five fold graph");
   graph::AdjacencyListGraph fiveFoldGraph = createFiveFoldGraph(minimal, s, t);
   const size_t numberOfNodes5FoldGraph    = fiveFoldGraph.numberOfNodes();
-  const graph::EarDecomposition openEars  = schmidt(fiveFoldGraph);                // calculate open ear decomposition
-  std::vector<size_t> wholeTour           = findHamiltonCycleInOpenEarDecomposition(openEars, numberOfNodes5FoldGraph);
-  const std::vector<size_t> tour          = extractHamiltonPath(wholeTour, s, t);  // extract s-t-path from solution
-  const graph::Edge bottleneckEdge        = findBottleneck(completeGraph, tour, false);
-  const double objective                  = completeGraph.weight(bottleneckEdge);
-
-  assert(objective / maxEdgeWeight <= 2 && objective / maxEdgeWeight >= 1 && "A fortiori guarantee is nonsense!");
-  return Result{biconnectedGraph, openEars, tour, bottleneckEdge, objective, maxEdgeWeight, minimal.numberOfEdges()};
+  scope.next("schmidt");
+  graph::EarDecomposition openEars = chainDecomposition(fiveFoldGraph);  // calculate open ear decomposition
+  scope.next("hamilton cycle");
+  std::vector<size_t> wholeTour = findHamiltonCycleInOpenEarDecomposition(openEars, numberOfNodes5FoldGraph);
+  std::vector<size_t> tour      = extractHamiltonPath(wholeTour, s, t);  // extract s-t-path from solution
+  scope.next("bottleneck");
+  const graph::Edge bottleneckEdge = findBottleneck(completeGraph, tour, false);
+  const double objective           = completeGraph.weight(bottleneckEdge);
+  scope.stop();
+
+  assert(objective >= maxEdgeWeight && "A fortiori guarantee is nonsense!");
+  assert((!satisfiesTriangleInequality<G>() || objective <= 2 * maxEdgeWeight) && "A fortiori guarantee is nonsense!");
+  return makeResult<Policy>(std::move(biconnectedGraph),
+                            std::move(openEars),
+                            std::move(tour),
+                            bottleneckEdge,
+                            objective,
+                            maxEdgeWeight,
+                            minimal.numberOfEdges());
 }
 
 /*!
  * @brief approximates an instance of BTSPP
  * @details Computes the bottleneck optimal almost biconnected subgraph that is biconnected when augmented with the edge (s,t).
+ * @tparam Policy decides which intermediate graphs are retained in the result
  * @tparam G type of complete graph
  * @param completeGraph complete weighted graph provinding the distances between nodes
  * @param s start node
  * @param t end node
  * @return Result
  */
-template <typename G>
+template <ResultPolicy Policy = ResultPolicy::Full, typename G>
   requires(std::is_base_of_v<graph::CompleteGraph, G> && std::is_base_of_v<graph::WeightedGraph, G>)
 Result approximateBTSPP(const G& completeGraph, const size_t s = 0, const size_t t = 1) {
   // find graph s.t. G = (V,E) + (s,t) is biconnected
-  const auto [biconnectedGraph, maxEdgeWeight] = edgeAugmentedBiconnectedSubgraph(completeGraph, graph::Edge{s, t});
-  return findHamiltonPathInBottleneckOptimalBiconnectedSubgraph(completeGraph, biconnectedGraph, maxEdgeWeight, s, t);
+  perfcounter::Scope scope("biconnected subgraph");
+  auto [biconnectedGraph, maxEdgeWeight] = edgeAugmentedBiconnectedSubgraph(completeGraph, graph::Edge{s, t});
+  scope.stop();
+  return findHamiltonPathInBottleneckOptimalBiconnectedSubgraph<Policy>(completeGraph, std::move(biconnectedGraph), maxEdgeWeight, s, t);
 }
 
 /*!
  * @brief approximates an instance of BTSVPP
  * @details Computes the bottleneck optimal almost biconnected subgraph such that there is an edge, which augemnts it to a biconnected
  * graph.
+ * @tparam Policy decides which intermediate graphs are retained in the result
  * @tparam G type of complete graph
  * @param completeGraph complete weighted graph provinding the distances between nodes
  * @return Result
  */
-template <typename G>
+template <ResultPolicy Policy = ResultPolicy::Full, typename G>
   requires(std::is_base_of_v<graph::CompleteGraph, G> && std::is_base_of_v<graph::WeightedGraph, G>)
 Result approximateBTSVPP(const G& completeGraph) {
-  const auto [biconnectedGraph, maxEdgeWeight, augmentationEdge] = almostBiconnectedSubgraph(completeGraph);
-  return findHamiltonPathInBottleneckOptimalBiconnectedSubgraph(completeGraph,
-                                                                biconnectedGraph,
-                                                                maxEdgeWeight,
-                                                                augmentationEdge.u,
-                                                                augmentationEdge.v);
+  perfcounter::Scope scope("biconnected subgraph");
+  auto [biconnectedGraph, maxEdgeWeight, augmentationEdge] = almostBiconnectedSubgraph(completeGraph);
+  scope.stop();
+  return findHamiltonPathInBottleneckOptimalBiconnectedSubgraph<Policy>(completeGraph,
+                                                                        std::move(biconnectedGraph),
+                                                                        maxEdgeWeight,
+                                                                        augmentationEdge.u,
+                                                                        augmentationEdge.v);
 }
 }  // namespace approximation
@@ -0,0 +1,49 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*! \file chaindecomposition.hpp
+ * Iterative chain decomposition after Schmidt. The depth first search runs on an explicit stack and the graph is
+ * copied into flat compressed sparse row arrays first, so that neither the call stack nor scattered adjacency vectors
+ * limit the size of the instances.
+ */
+
+// graph library
+#include "graph.hpp"
+
+namespace approximation {
+/*!
+ * @brief computes the chain decomposition of a connected graph
+ * @details The first chain is the cycle closed by the first back edge at the root, every other chain is a path whose
+ * endpoints lie on earlier chains. For a biconnected graph the chains form an open ear decomposition. As in the graph
+ * library the ears are stored in reverse order, the first ear is the last one in the vector and repeats its first node
+ * at the end.
+ * @param graph connected graph without parallel edges, less than 2^32 nodes
+ * @return chains as ear decomposition
+ */
+graph::EarDecomposition chainDecomposition(const graph::AdjacencyListGraph& graph);
+
+/*!
+ * @brief removes all ears consisting of a single edge
+ * @details Such an edge is never 2-essential and the remaining ears are still an open ear decomposition of the graph
+ * they span, since trivial ears contain no inner nodes other ears could start or end at.
+ * @param ears ear decomposition
+ */
+void removeTrivialEars(graph::EarDecomposition& ears);
+}  // namespace approximation
@@ -18,6 +18,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <fstream>
 #include <utility>
 #include <vector>
@@ -28,26 +29,74 @@
 #include "exception/exceptions.hpp"
 
 #include "solve/definitions.hpp"
+#include "solve/edgeranks.hpp"
+#include "solve/tourevaluation.hpp"
 
+/*!
+ * @brief squared euclidean distance between u and v, orders the edges like their lengths without a square root
+ */
+inline double squaredDistance(const graph::Euclidean& euclidean, const size_t u, const size_t v) {
+  const graph::Point2D difference = euclidean.position(u) - euclidean.position(v);
+  return difference.x * difference.x + difference.y * difference.y;
+}
+
+/*!
+ * @brief key to compare edges in bottleneck computations, only the order of the keys is meaningful
+ * @details Weighted graphs compare their weights, euclidean graphs their squared distances and edge ranks their ranks.
+ */
 template <typename G>
-  requires(std::is_base_of_v<graph::CompleteGraph, G> && std::is_base_of_v<graph::WeightedGraph, G>)
-graph::Edge findBottleneck(const G& completeGraph, const std::vector<size_t>& tour, const bool isCycle) {
+  requires(std::is_base_of_v<graph::WeightedGraph, G>)
+double bottleneckKey(const G& weightedGraph, const size_t u, const size_t v) {
+  return weightedGraph.weight(u, v);
+}
+
+inline double bottleneckKey(const graph::Euclidean& euclidean, const size_t u, const size_t v) {
+  return squaredDistance(euclidean, u, v);
+}
+
+inline uint32_t bottleneckKey(const EdgeRanks& ranks, const size_t u, const size_t v) {
+  return ranks.rank(u, v);
+}
+
+/*!
+ * @brief finds a longest edge in tour
+ * @details The edges are compared by bottleneckKey(), so the lengths are never computed.
+ * @tparam Weights complete weighted graph or EdgeRanks
+ * @param weights provides the keys of the edges
+ * @param tour order of the nodes
+ * @param isCycle true if the edge from the last to the first node belongs to the tour
+ * @return a longest edge
+ */
+template <typename Weights>
+graph::Edge findBottleneck(const Weights& weights, const std::vector<size_t>& tour, const bool isCycle) {
   size_t bottleneckEdgeEnd = 0;
-  double bottleneckWeight  = completeGraph.weight(tour[0], tour[1]);
-  for (size_t i = 1; i < completeGraph.numberOfNodes() - 1; ++i) {
-    if (completeGraph.weight(tour[i], tour[i + 1]) > bottleneckWeight) {
+  auto bottleneck          = bottleneckKey(weights, tour[0], tour[1]);
+  for (size_t i = 1; i + 1 < tour.size(); ++i) {
+    const auto key = bottleneckKey(weights, tour[i], tour[i + 1]);
+    if (key > bottleneck) {
       bottleneckEdgeEnd = i;
-      bottleneckWeight  = completeGraph.weight(tour[i], tour[i + 1]);
+      bottleneck        = key;
     }
   }
-  if (isCycle && completeGraph.weight(tour.back(), tour[0]) > bottleneckWeight) {
-    return graph::Edge{tour.back(), 0};
+  if (isCycle && bottleneckKey(weights, tour.back(), tour.front()) > bottleneck) {
+    return graph::Edge{tour.back(), tour.front()};
   }
   else {
     return graph::Edge{tour[bottleneckEdgeEnd], tour[bottleneckEdgeEnd + 1]};
   }
 }
 
+/*!
+ * @brief finds a longest edge in tour with the vectorised tour evaluation, the length of the tour isn't computed
+ * @param euclidean complete euclidean graph
+ * @param tour order of the nodes
+ * @param isCycle true if the edge from the last to the first node belongs to the tour
+ * @return the first longest edge
+ */
+inline graph::Edge findBottleneck(const graph::Euclidean& euclidean, const std::vector<size_t>& tour, const bool isCycle) {
+  return tourevaluation::edgeAt(tour, tourevaluation::evaluateBottleneck(euclidean.vertices(), tour, isCycle).bottleneckPosition);
+}
+
 inline std::ostream& operator<<(std::ostream& os, const ProblemType type) {
   if (type == ProblemType::BTSP_approx || type == ProblemType::BTSP_exact) {
     os << "BTSP";
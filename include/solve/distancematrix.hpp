@@ -0,0 +1,102 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// graph library
+#include "graph.hpp"
+
+/*!
+ * @brief DistanceMatrix is a complete graph whose weights are given explicitly
+ * @details Only the upper triangle is stored, either as float or quantised to uint16_t, which halves the memory of
+ * floats and quarters the memory of doubles. Quantised weights are mapped linearly onto [min, max] of the distances,
+ * so that the order of the edges is kept up to the resolution of 1/65535 of the range, bottleneck tours are therefore
+ * only approximately optimal. With the rank transform the weights are replaced by the ranks of the distances, edges of
+ * equal distance share a rank. Bottleneck tours only depend on the order of the edges, so they stay optimal under the
+ * transform, while objectives are reported as ranks. The transform is rejected with InvalidArgument if there are more
+ * distinct distances than ranks the entries represent exactly, i.e. 65536 for uint16_t and 2^24 for float. The triangle
+ * inequality isn't checked, so the factor 2 guarantee of the approximations isn't asserted for distance matrices.
+ * @tparam Entry float or uint16_t
+ */
+template <typename Entry>
+  requires(std::is_same_v<Entry, float> || std::is_same_v<Entry, uint16_t>)
+class DistanceMatrix : public graph::CompleteGraph, public graph::WeightedGraph {
+public:
+  static constexpr bool METRIC = false; /**< the weights may violate the triangle inequality */
+
+  /*!
+   * @brief takes the encoded entries, readDistanceMatrix() encodes the distances of a file
+   * @param numberOfNodes number of nodes in the graph
+   * @param entries entry of every edge {u, v} with v < u, stored row by row
+   * @param offset weight of entry 0
+   * @param scale weight difference between consecutive entries
+   * @param ranked true if the entries are ranks of the distances
+   */
+  DistanceMatrix(const size_t numberOfNodes, std::vector<Entry>&& entries, const double offset, const double scale, const bool ranked) :
+    pNumberOfNodes(numberOfNodes), pRanked(ranked), pOffset(offset), pScale(scale), pEntries(std::move(entries)) {}
+
+  size_t numberOfNodes() const final { return pNumberOfNodes; }
+
+  double weight(const size_t u, const size_t v) const final { return pOffset + pScale * entry(u, v); }
+  double weight(const graph::Edge& edge) const { return weight(edge.u, edge.v); }
+
+  /*!
+   * @brief stored entry of the edge {u, v}, u != v, entries are ordered like the weights
+   */
+  Entry entry(const size_t u, const size_t v) const { return pEntries[u > v ? triangularIndex(u, v) : triangularIndex(v, u)]; }
+
+  /*!
+   * @brief true if the weights are ranks of the distances
+   */
+  bool ranked() const { return pRanked; }
+
+private:
+  static size_t triangularIndex(const size_t u, const size_t v) { return u * (u - 1) / 2 + v; }
+
+  size_t pNumberOfNodes;
+  bool pRanked;
+  double pOffset;              /**< weight of entry 0 */
+  double pScale;               /**< weight difference between consecutive entries */
+  std::vector<Entry> pEntries; /**< entry of every edge {u, v} with v < u, stored row by row */
+};
+
+/*!
+ * @brief reads a distance matrix from a text file
+ * @details The file starts with the number of nodes n followed by the n x n matrix row by row. Only the entries below
+ * the diagonal are kept, so the matrix is assumed to be symmetric. The file is read twice, once for the range or the
+ * distinct values of the distances and once to encode them directly into the entries, so no other copy of the matrix
+ * is held. Distinct values are collected for the rank transform only, at most twice the number of ranks at once.
+ * @param filename name of the file
+ * @param rankTransform replace the distances by their ranks
+ */
+template <typename Entry>
+DistanceMatrix<Entry> readDistanceMatrix(const std::string& filename, const bool rankTransform);
+
+/*!
+ * @brief key to compare edges of a distance matrix in bottleneck computations
+ */
+template <typename Entry>
+Entry bottleneckKey(const DistanceMatrix<Entry>& matrix, const size_t u, const size_t v) {
+  return matrix.entry(u, v);
+}
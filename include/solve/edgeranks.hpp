@@ -0,0 +1,82 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// graph library
+#include "graph.hpp"
+
+#include "solve/distancematrix.hpp"
+
+/*!
+ * @brief EdgeRanks replaces the lengths of all edges of a complete graph by their rank in the sorted order
+ * @details Bottleneck objectives only depend on the order of the edge lengths. The edges are sorted once by their
+ * squared length, edges of equal length share a rank. Every bottleneck comparison can then be done on 32 bit integers
+ * without any square root, lengths are only computed for reporting.
+ */
+class EdgeRanks {
+public:
+  /*!
+   * @brief sorts the edges of euclidean and assigns the ranks
+   * @param euclidean complete euclidean graph
+   */
+  explicit EdgeRanks(const graph::Euclidean& euclidean);
+
+  /*!
+   * @brief sorts the edges of matrix by their entries and assigns the ranks
+   * @param matrix complete graph given by a distance matrix
+   */
+  template <typename Entry>
+  explicit EdgeRanks(const DistanceMatrix<Entry>& matrix);
+
+  /*!
+   * @brief rank of the edge {u, v}, u != v
+   */
+  uint32_t rank(const size_t u, const size_t v) const { return pRanks[u > v ? triangularIndex(u, v) : triangularIndex(v, u)]; }
+
+  /*!
+   * @brief rank of edge
+   */
+  uint32_t rank(const graph::Edge& edge) const { return rank(edge.u, edge.v); }
+
+  /*!
+   * @brief number of distinct edge lengths, all ranks are smaller
+   */
+  uint32_t numberOfRanks() const { return pNumberOfRanks; }
+
+  /*!
+   * @brief number of nodes in the graph the ranks were computed for
+   */
+  size_t numberOfNodes() const { return pNumberOfNodes; }
+
+private:
+  static size_t triangularIndex(const size_t u, const size_t v) { return u * (u - 1) / 2 + v; }
+
+  /*!
+   * @brief assigns the ranks in the order of keys, which are stored like the ranks
+   */
+  template <typename Key>
+  void assignRanks(const std::vector<Key>& keys);
+
+  size_t pNumberOfNodes;
+  uint32_t pNumberOfRanks;
+  std::vector<uint32_t> pRanks; /**< rank of every edge {u, v} with v < u, stored row by row */
+};
@@ -25,6 +25,12 @@
 
 #include "solve/definitions.hpp"
 
+/*!
+ * @brief draws a fresh seed from the system's random device
+ * @return seed that can be passed to generateEuclideanDistanceGraph()
+ */
+std::array<uint_fast32_t, SEED_LENGTH> generateSeed();
+
 graph::Euclidean generateEuclideanDistanceGraph(unsigned int numOfNodes, bool surpressSeed = false);
 graph::Euclidean generateEuclideanDistanceGraph(unsigned int numOfNodes,
                                                 const std::array<uint_fast32_t, SEED_LENGTH>& randomData,
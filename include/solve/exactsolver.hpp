@@ -18,9 +18,12 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 #include <solve/definitions.hpp>
+#include <solve/distancematrix.hpp>
 
 // graph library
 #include "graph.hpp"
@@ -41,12 +44,41 @@ struct Result {
  */
 void printInfo(const exactsolver::Result& res, const ProblemType problemType, const double runtime = -1.0);
 
+/*!
+ * @brief estimates the peak memory needed to solve an instance without building the model
+ * @details The estimate covers the assembly of the constraint matrix, the cached structure of the model and the
+ * copies made by HiGHS, anti crossing constraints are not taken into account.
+ * @param numberOfNodes number of nodes in the graph
+ * @param problemType type of instance
+ * @return estimated peak memory in bytes
+ */
+size_t estimateMemory(const size_t numberOfNodes, const ProblemType problemType);
+
 /*!
  * @brief solves an instance of BTSP, BTSPP or TSP
+ * @details Small instances are solved by the dynamic program in heldkarp.hpp instead of a MILP.
  * @param euclidean euclidean graph
  * @param problemType type of instance
  * @param noCrossing if BTSP the solution can be forced to have no crossings
+ * @param interrupted polled by HiGHS while it runs, the solve throws Interrupted as soon as it returns true
+ */
+Result solve(const graph::Euclidean& euclidean,
+             const ProblemType problemType,
+             const bool noCrossing                    = false,
+             const std::function<bool()>& interrupted = {});
+
+/*!
+ * @brief solves an instance of BTSP, BTSPP or TSP given by a distance matrix
+ * @param matrix complete graph given by a distance matrix
+ * @param problemType type of instance
+ */
+Result solve(const DistanceMatrix<float>& matrix, const ProblemType problemType);
+
+/*!
+ * @brief solves an instance of BTSP, BTSPP or TSP given by a quantised distance matrix
+ * @param matrix complete graph given by a quantised distance matrix
+ * @param problemType type of instance
  */
-Result solve(const graph::Euclidean& euclidean, const ProblemType problemType, const bool noCrossing = false);
+Result solve(const DistanceMatrix<uint16_t>& matrix, const ProblemType problemType);
 
 }  // namespace exactsolver
@@ -0,0 +1,57 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*! \file heldkarp.hpp
+ * Exact dynamic program over subsets of nodes for small instances. Node 0 is the start, every other node is one bit
+ * of the subsets. TSP is solved in the (min, +) semiring, BTSP and BTSPP in the (min, max) semiring on edge ranks.
+ */
+
+#include <cstdint>
+
+// graph library
+#include "graph.hpp"
+
+#include "solve/definitions.hpp"
+#include "solve/distancematrix.hpp"
+#include "solve/exactsolver.hpp"
+
+namespace heldkarp {
+
+/*! largest instance solved by the dynamic program, the table then has 2^15 x 16 entries */
+constexpr size_t MAX_NODES = 16;
+
+/*!
+ * @brief solves an instance of BTSP, BTSPP or TSP with at most MAX_NODES nodes
+ * @param euclidean euclidean graph
+ * @param problemType type of instance
+ */
+exactsolver::Result solve(const graph::Euclidean& euclidean, const ProblemType problemType);
+
+/*!
+ * @brief solves an instance of BTSP, BTSPP or TSP with at most MAX_NODES nodes given by a distance matrix
+ */
+exactsolver::Result solve(const DistanceMatrix<float>& matrix, const ProblemType problemType);
+
+/*!
+ * @brief solves an instance of BTSP, BTSPP or TSP with at most MAX_NODES nodes given by a quantised distance matrix
+ */
+exactsolver::Result solve(const DistanceMatrix<uint16_t>& matrix, const ProblemType problemType);
+
+}  // namespace heldkarp
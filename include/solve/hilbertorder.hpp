@@ -0,0 +1,82 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*! \file hilbertorder.hpp
+ * Renumbering of the vertices along a Hilbert curve. Vertices that are close in the plane get close ids, so that the
+ * graph algorithms of the approximation access their adjacency lists with far fewer cache misses than in the random
+ * order of the generation.
+ */
+
+#include <vector>
+
+// graph library
+#include "geometry.hpp"
+#include "graph.hpp"
+
+#include "solve/approximation.hpp"
+
+namespace hilbertorder {
+/*!
+ * @brief sorts the positions along a Hilbert curve through their bounding box
+ * @param positions coordinates of the vertices
+ * @return order, order[i] is the original id of the vertex with new id i
+ */
+std::vector<size_t> hilbertOrder(const std::vector<graph::Point2D>& positions);
+
+/*!
+ * @brief Reordering is a copy of a euclidean graph with the vertices renumbered along a Hilbert curve
+ * @details Solve the renumbered graph() and map the result back to the original ids with restore().
+ */
+class Reordering {
+public:
+  /*!
+   * @brief computes the Hilbert order and the renumbered graph, recorded as stage "hilbert order"
+   * @param euclidean graph with the original ids
+   */
+  explicit Reordering(const graph::Euclidean& euclidean);
+
+  /*!
+   * @brief renumbered graph
+   */
+  const graph::Euclidean& graph() const { return pGraph; }
+
+  /*!
+   * @brief new id of the vertex with id original
+   */
+  size_t renumbered(const size_t original) const { return pRenumbered[original]; }
+
+  /*!
+   * @brief original id of the vertex with id renumbered
+   */
+  size_t original(const size_t renumbered) const { return pOrder[renumbered]; }
+
+  /*!
+   * @brief maps all vertex ids in result of the renumbered graph back to the original ids, recorded as stage "restore ids"
+   * @param result approximation of graph()
+   * @return approximation of the original graph
+   */
+  approximation::Result restore(approximation::Result&& result) const;
+
+private:
+  std::vector<size_t> pOrder;      /**< original id of every new id */
+  std::vector<size_t> pRenumbered; /**< new id of every original id */
+  graph::Euclidean pGraph;         /**< renumbered graph */
+};
+}  // namespace hilbertorder
@@ -0,0 +1,138 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*! \file metricgraph.hpp
+ * Complete graphs whose distance is a compile time policy. The distance of every metric is inlined into the
+ * approximation templates, since MetricGraph::weight() is final and findBottleneck() compares the metric's key.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+// graph library
+#include "geometry.hpp"
+#include "graph.hpp"
+
+namespace metric {
+/*!
+ * @brief Type lists the metrics that can be selected at run time
+ */
+enum class Type {
+  Euclidean,
+  SquaredEuclidean,
+  Manhattan,
+  Chebyshev,
+  Haversine
+};
+
+/*!
+ * @brief Every metric provides the distance and a key that orders the edges like the distance but is cheaper to compute
+ * @details METRIC tells if the distance satisfies the triangle inequality, the factor 2 guarantee of the approximations
+ * only holds then.
+ */
+struct Euclidean {
+  static constexpr bool METRIC = true;
+
+  static double key(const graph::Point2D& a, const graph::Point2D& b) {
+    const graph::Point2D d = a - b;
+    return d.x * d.x + d.y * d.y;
+  }
+  static double distance(const graph::Point2D& a, const graph::Point2D& b) { return std::sqrt(key(a, b)); }
+};
+
+/*!
+ * @brief squared euclidean distance, it violates the triangle inequality, so approximations have no factor 2 guarantee
+ */
+struct SquaredEuclidean {
+  static constexpr bool METRIC = false;
+
+  static double key(const graph::Point2D& a, const graph::Point2D& b) { return Euclidean::key(a, b); }
+  static double distance(const graph::Point2D& a, const graph::Point2D& b) { return key(a, b); }
+};
+
+struct Manhattan {
+  static constexpr bool METRIC = true;
+
+  static double key(const graph::Point2D& a, const graph::Point2D& b) { return std::abs(a.x - b.x) + std::abs(a.y - b.y); }
+  static double distance(const graph::Point2D& a, const graph::Point2D& b) { return key(a, b); }
+};
+
+struct Chebyshev {
+  static constexpr bool METRIC = true;
+
+  static double key(const graph::Point2D& a, const graph::Point2D& b) { return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y)); }
+  static double distance(const graph::Point2D& a, const graph::Point2D& b) { return key(a, b); }
+};
+
+/*!
+ * @brief great circle distance in kilometres, x is the longitude and y the latitude in degrees
+ * @details The key is the haversine of the central angle, which grows monotonically with the distance, so comparisons
+ * need neither the square root nor the arcsine.
+ */
+struct Haversine {
+  static constexpr bool METRIC         = true;
+  static constexpr double EARTH_RADIUS = 6371.0088;  // mean earth radius in kilometres
+  static constexpr double RADIANS      = std::numbers::pi / 180.0;
+
+  static double key(const graph::Point2D& a, const graph::Point2D& b) {
+    const double sinLatitude  = std::sin(0.5 * RADIANS * (b.y - a.y));
+    const double sinLongitude = std::sin(0.5 * RADIANS * (b.x - a.x));
+    return sinLatitude * sinLatitude + std::cos(RADIANS * a.y) * std::cos(RADIANS * b.y) * sinLongitude * sinLongitude;
+  }
+  static double distance(const graph::Point2D& a, const graph::Point2D& b) {
+    return 2.0 * EARTH_RADIUS * std::asin(std::sqrt(std::min(1.0, key(a, b))));
+  }
+};
+}  // namespace metric
+
+/*!
+ * @brief MetricGraph is a complete graph on points in the plane with the distance given by Metric
+ * @details It holds a copy of the positions and implements the complete weighted graph interface, so that it satisfies
+ * the approximation templates. It isn't a graph::Euclidean, so no euclidean overload applies to it by accident.
+ * @tparam Metric one of the structs in namespace metric
+ */
+template <typename Metric>
+class MetricGraph : public graph::CompleteGraph, public graph::WeightedGraph {
+public:
+  static constexpr bool METRIC = Metric::METRIC; /**< true if the weights satisfy the triangle inequality */
+
+  explicit MetricGraph(const std::vector<graph::Point2D>& positions) : pPositions(positions) {}
+
+  size_t numberOfNodes() const final { return pPositions.size(); }
+
+  double weight(const size_t u, const size_t v) const final { return Metric::distance(pPositions[u], pPositions[v]); }
+  double weight(const graph::Edge& edge) const { return weight(edge.u, edge.v); }
+
+  const graph::Point2D& position(const size_t u) const { return pPositions[u]; }
+  const std::vector<graph::Point2D>& vertices() const { return pPositions; }
+
+private:
+  std::vector<graph::Point2D> pPositions;
+};
+
+/*!
+ * @brief key to compare edges of a MetricGraph in bottleneck computations
+ */
+template <typename Metric>
+double bottleneckKey(const MetricGraph<Metric>& metricGraph, const size_t u, const size_t v) {
+  return Metric::key(metricGraph.position(u), metricGraph.position(v));
+}
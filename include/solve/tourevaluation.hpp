@@ -0,0 +1,60 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*! \file tourevaluation.hpp
+ * Evaluation of tours in euclidean graphs. The coordinates are gathered in tour order and the longest edge and its
+ * position are computed in a single pass on squared lengths, vectorised with AVX2 if the compiler targets it (the
+ * project is compiled with -march=native) and scalar otherwise.
+ */
+
+#include <vector>
+
+// graph library
+#include "geometry.hpp"
+#include "graph.hpp"
+
+namespace tourevaluation {
+/*!
+ * @brief Evaluation bundles the measures of one tour
+ */
+struct Evaluation {
+  size_t bottleneckPosition = 0; /**< position i of the first longest edge {tour[i], tour[i + 1]} */
+  double bottleneckSquared  = 0; /**< squared length of the longest edge */
+};
+
+/*!
+ * @brief computes the longest edge of a tour, without a square root per edge
+ * @param positions coordinates of the nodes
+ * @param tour order of the nodes, at least two nodes
+ * @param isCycle true if the edge from the last to the first node belongs to the tour, it has position tour.size() - 1
+ * @return evaluation of the tour
+ */
+Evaluation evaluateBottleneck(const std::vector<graph::Point2D>& positions, const std::vector<size_t>& tour, const bool isCycle);
+
+/*!
+ * @brief edge at position of the evaluated tour
+ * @param tour order of the nodes
+ * @param position position of the edge as in Evaluation::bottleneckPosition
+ * @return edge {tour[position], tour[position + 1]}, the successor of the last node is the first one
+ */
+inline graph::Edge edgeAt(const std::vector<size_t>& tour, const size_t position) {
+  return graph::Edge{tour[position], tour[position + 1 < tour.size() ? position + 1 : 0]};
+}
+}  // namespace tourevaluation
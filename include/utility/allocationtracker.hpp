@@ -0,0 +1,60 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*! \file allocationtracker.hpp
+ * Counts heap allocations of the calling thread. The global operator new and delete are only replaced if the project is
+ * compiled with ALLOCATION_TRACKING=1, otherwise all statistics are 0.
+ */
+
+#include <cstddef>
+
+namespace allocationtracker {
+#if (ALLOCATION_TRACKING)
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+/*!
+ * @brief Statistics bundles the allocations of one thread since the last reset
+ */
+struct Statistics {
+  size_t allocations = 0; /**< number of calls to operator new */
+  size_t bytes       = 0; /**< number of bytes requested from operator new */
+  size_t peakBytes   = 0; /**< maximum of bytes alive at the same time, counted relative to the last reset */
+};
+
+#if (ALLOCATION_TRACKING)
+/*!
+ * @brief restarts counting in the calling thread
+ */
+void reset();
+
+/*!
+ * @brief reads the statistics of the calling thread since the last reset
+ */
+Statistics read();
+#else
+inline void reset() {}
+inline Statistics read() {
+  return Statistics{};
+}
+#endif
+}  // namespace allocationtracker
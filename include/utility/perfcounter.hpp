@@ -0,0 +1,104 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*! \file perfcounter.hpp
+ * Hardware performance counters per stage of a computation. The counters are only recorded if the project is compiled
+ * with PERF_COUNTERS=1 on Linux, otherwise all functions are no-ops.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace perfcounter {
+constexpr size_t NUMBER_OF_EVENTS = 4; /**< cycles, instructions, cache misses, branch misses */
+
+/*!
+ * @brief Counts bundles the measured quantities of one stage
+ */
+struct Counts {
+  double milliseconds = 0.0;                       /**< elapsed wall time */
+  std::array<uint64_t, NUMBER_OF_EVENTS> events{}; /**< cycles, instructions, cache misses, branch misses */
+};
+
+#if (PERF_COUNTERS)
+/*!
+ * @brief Scope records the counters from construction (or the last call to next()) until destruction (or stop())
+ * @details The counts are accumulated per stage name in the calling thread, nested scopes count inclusively.
+ */
+class Scope {
+public:
+  explicit Scope(const char* stage) { start(stage); }
+  ~Scope() { stop(); }
+
+  /*!
+   * @brief stops the current stage and starts recording the next one
+   * @param stage name of the next stage, must outlive the recording
+   */
+  void next(const char* stage) {
+    stop();
+    start(stage);
+  }
+
+  /*!
+   * @brief stops the current stage, further calls have no effect until next() is called
+   */
+  void stop();
+
+private:
+  void start(const char* stage);
+
+  const char* pStage = nullptr; /**< name of the stage currently recorded */
+  Counts pStart;                /**< counts at start of the current stage */
+  std::chrono::time_point<std::chrono::steady_clock> pStartTime;
+};
+
+/*!
+ * @brief discards all stages recorded in the calling thread
+ */
+void reset();
+
+/*!
+ * @brief prints a table of the stages recorded in the calling thread
+ * @param os stream to print to
+ */
+void print(std::ostream& os);
+
+/*!
+ * @brief writes the stages recorded in the calling thread as comma separated values
+ * @details For every stage ,<name>,<ms>,<cycles>,<instructions>,<cache misses>,<branch misses> is written.
+ * @param os stream to write to
+ */
+void writeToFile(std::ostream& os);
+#else
+class Scope {
+public:
+  explicit Scope([[maybe_unused]] const char* stage) {}
+  void next([[maybe_unused]] const char* stage) {}
+  void stop() {}
+};
+
+inline void reset() {}
+inline void print([[maybe_unused]] std::ostream& os) {}
+inline void writeToFile([[maybe_unused]] std::ostream& os) {}
+#endif
+}  // namespace perfcounter
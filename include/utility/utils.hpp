@@ -85,13 +85,13 @@ public:
   Stopwatch()  = default;
   ~Stopwatch() = default;
 
-  void reset() { pStartTime = std::chrono::high_resolution_clock::now(); }
+  void reset() { pStartTime = std::chrono::steady_clock::now(); }
 
   double elapsedTimeInMilliseconds() const {
-    const std::chrono::time_point<std::chrono::high_resolution_clock> now = std::chrono::high_resolution_clock::now();
-    return std::round(std::chrono::duration_cast<std::chrono::microseconds>(now - pStartTime).count()) / 1000.0;
+    const std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now - pStartTime).count() / 1000000.0;
   }
 
 private:
-  std::chrono::time_point<std::chrono::high_resolution_clock> pStartTime;
+  std::chrono::time_point<std::chrono::steady_clock> pStartTime;
 };
\ No newline at end of file
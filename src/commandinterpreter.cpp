@@ -18,25 +18,46 @@
  */
 #include "commandinterpreter.hpp"
 
+#include <algorithm>
 #include <array>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 // graph library
 #include "graph.hpp"
 
 #include "exception/exceptions.hpp"
 
+#include "export/exporter.hpp"
+#include "export/rasteriser.hpp"
+
 #include "solve/approximation.hpp"
 #include "solve/definitions.hpp"
+#include "solve/distancematrix.hpp"
 #include "solve/euclideandistancegraph.hpp"
 #include "solve/exactsolver.hpp"
+#include "solve/hilbertorder.hpp"
+#include "solve/metricgraph.hpp"
 
+#include "utility/allocationtracker.hpp"
+#include "utility/perfcounter.hpp"
 #include "utility/utils.hpp"
+
+#include "service.hpp"
 /***********************************************************************************************************************
  *                                                      general
  **********************************************************************************************************************/
@@ -111,80 +132,534 @@ void interpretCommandLine(const int argc, char* argv[]) {
  **********************************************************************************************************************/
 
 #if not(VISUALISATION)
-constexpr std::string_view LOG_FILE_IDENTIFIER   = "-logfile:=";
-constexpr std::string_view REPETITION_IDENTIFIER = "-repetitions:=";
-constexpr std::string_view SUPPRESS_INFO_TAG     = "-no-info";
-constexpr std::string_view SUPPRESS_SEED_TAG     = "-no-seed";
-constexpr std::string_view NO_CROSSING_TAG       = "-no-crossing";
-constexpr std::string_view BTSP_APPROX_TAG       = "-btsp";
-constexpr std::string_view BTSPP_APPROX_TAG      = "-btspp";
-constexpr std::string_view BTSVPP_APPROX_TAG     = "-btsvpp";
-constexpr std::string_view BTSP_EXACT_TAG        = "-btsp-e";
-constexpr std::string_view BTSPP_EXACT_TAG       = "-btspp-e";
-constexpr std::string_view TSP_EXACT_TAG         = "-tsp-e";
+constexpr std::string_view LOG_FILE_IDENTIFIER      = "-logfile:=";
+constexpr std::string_view REPETITION_IDENTIFIER    = "-repetitions:=";
+constexpr std::string_view SEED_RANGE_IDENTIFIER    = "-seed-range:=";
+constexpr std::string_view SEED_RANGE_SEPARATOR     = "..";
+constexpr std::string_view MEMORY_BUDGET_IDENTIFIER = "-memory-budget:=";
+constexpr std::string_view EXPORT_PNG_IDENTIFIER    = "-export-png:=";
+constexpr std::string_view METRIC_IDENTIFIER        = "-metric:=";
+constexpr std::string_view SUPPRESS_INFO_TAG        = "-no-info";
+constexpr std::string_view SUPPRESS_SEED_TAG        = "-no-seed";
+constexpr std::string_view NO_CROSSING_TAG          = "-no-crossing";
+constexpr std::string_view HILBERT_ORDER_TAG        = "-hilbert";
+constexpr std::string_view BTSP_APPROX_TAG          = "-btsp";
+constexpr std::string_view BTSPP_APPROX_TAG         = "-btspp";
+constexpr std::string_view BTSVPP_APPROX_TAG        = "-btsvpp";
+constexpr std::string_view BTSP_EXACT_TAG           = "-btsp-e";
+constexpr std::string_view BTSPP_EXACT_TAG          = "-btspp-e";
+constexpr std::string_view TSP_EXACT_TAG            = "-tsp-e";
+constexpr size_t MEBIBYTE                           = 1024 * 1024;
+constexpr std::string_view SERVICE_KEYWORD          = "serve";
+constexpr std::string_view BINARY_INPUT_TAG         = "-binary";
+constexpr std::string_view MATRIX_KEYWORD           = "matrix";
+constexpr std::string_view QUANTISED_TAG            = "-quantised";
+constexpr std::string_view RANK_TRANSFORM_TAG       = "-ranks";
+constexpr unsigned int IMAGE_SIZE                   = 1000;  // width and height of exported images in pixels
+
+constexpr approximation::ResultPolicy BATCH_RESULT_POLICY = approximation::ResultPolicy::Compact;  // only measures are logged
+
+constexpr std::array<std::pair<std::string_view, ProblemType>, std::to_underlying(ProblemType::NUMBER_OF_OPTIONS)> PROBLEM_TYPE_TAGS{
+    std::pair{BTSP_APPROX_TAG,   ProblemType::BTSP_approx},
+    std::pair{BTSPP_APPROX_TAG,  ProblemType::BTSPP_approx},
+    std::pair{BTSVPP_APPROX_TAG, ProblemType::BTSVPP_approx},
+    std::pair{BTSP_EXACT_TAG,    ProblemType::BTSP_exact},
+    std::pair{BTSPP_EXACT_TAG,   ProblemType::BTSPP_exact},
+    std::pair{TSP_EXACT_TAG,     ProblemType::TSP_exact}
+};
+
+constexpr std::array<std::pair<std::string_view, metric::Type>, 5> METRIC_NAMES{
+    std::pair{"euclidean",         metric::Type::Euclidean},
+    std::pair{"squared-euclidean", metric::Type::SquaredEuclidean},
+    std::pair{"manhattan",         metric::Type::Manhattan},
+    std::pair{"chebyshev",         metric::Type::Chebyshev},
+    std::pair{"haversine",         metric::Type::Haversine}
+};
+
+/*!
+ * @brief SeedSequence describes the seeds of all instances to solve without listing them
+ * @details The seed of instance i is computed from its index when the instance is generated: it equals first, except
+ * that i is added to the first part unless the seed is fixed. Every problem type therefore solves the same instances.
+ */
+struct SeedSequence {
+  size_t size                                  = 0;     /**< number of instances to solve */
+  std::array<uint_fast32_t, SEED_LENGTH> first = {};    /**< seed of the first instance */
+  bool fixed                                   = false; /**< all instances use first, e.g. to repeat one instance */
+
+  std::array<uint_fast32_t, SEED_LENGTH> operator[](const size_t index) const {
+    std::array<uint_fast32_t, SEED_LENGTH> seed = first;
+    if (!fixed) {
+      seed[0] += index;
+    }
+    return seed;
+  }
+};
+
+/*!
+ * @brief Settings bundles the options read from the command line that apply to all problem types
+ */
+struct Settings {
+  std::string filename            = "";                      /**< file to append stats to, empty if no logfile is written */
+  bool suppressInfo               = false;                   /**< suppress detailed terminal output */
+  bool suppressSeed               = false;                   /**< suppress seed output in terminal */
+  size_t memoryBudget             = 0;                       /**< memory available for one instance in bytes, 0 if unlimited */
+  std::string imageDirectory      = "";                      /**< directory to export images to, empty if no images are exported */
+  imageexport::Exporter* exporter = nullptr;                 /**< renders the solved instances, nullptr if no images are exported */
+  bool hilbertOrder               = false;                   /**< renumber the vertices along a Hilbert curve before approximating */
+  metric::Type metric             = metric::Type::Euclidean; /**< distance used by the approximations */
+  SeedSequence seeds;                                        /**< seeds of the instances to solve */
+};
+
+/*!
+ * @brief Instance bundles a generated graph with the seed it was generated from
+ */
+struct Instance {
+  graph::Euclidean euclidean;                  /**< generated graph */
+  std::array<uint_fast32_t, SEED_LENGTH> seed; /**< seed to replay the generation of euclidean */
+};
 
 static void printAdvices() {
   std::cout << "<" << NO_CROSSING_TAG << "> if <-btsp-e> is set, to find a solution without crossing.\n";
   std::cout << "<" << LOG_FILE_IDENTIFIER << "<filename>> to write infos to <filename>.\n";
   std::cout << "<" << REPETITION_IDENTIFIER << "<numberOfRepetitions>> to compute several instances serial in one execution.\n";
+  std::cout << "<" << SEED_RANGE_IDENTIFIER << "<int1>" << SEED_RANGE_SEPARATOR
+            << "<int2>> to compute one instance for each seed <int> 0 ... with <int1> <= <int> <= <int2>.\n";
+  std::cout << "<" << MEMORY_BUDGET_IDENTIFIER << "<MiB>> to skip problem types whose estimated memory exceeds <MiB>.\n";
+  std::cout << "<" << EXPORT_PNG_IDENTIFIER << "<directory>> to render every solved instance to a PNG file in <directory>.\n";
+  std::cout << "<" << METRIC_IDENTIFIER
+            << "<metric>> to approximate with <metric> euclidean, squared-euclidean, manhattan, chebyshev or haversine.\n";
+  std::cout << "<" << HILBERT_ORDER_TAG << "> to renumber the vertices along a Hilbert curve before approximating.\n";
   std::cout << "<" << SUPPRESS_INFO_TAG << "> to suppress detailed terminal output.\n";
   std::cout << "<" << SUPPRESS_SEED_TAG << "> to suppress seed output in terminal.\n";
 }
-static void writeStatsToFile(const approximation::Result& res, const ProblemType type, const std::string& filename, const double runtime) {
+
+static void printSeed(const std::array<uint_fast32_t, SEED_LENGTH>& seed) {
+  std::cerr << "seed: ";
+  for (const uint_fast32_t part : seed) {
+    std::cerr << part << " ";
+  }
+  std::cerr << "\n";
+}
+
+static void writeSeedToFile(std::ofstream& outputfile, const std::array<uint_fast32_t, SEED_LENGTH>& seed) {
+  for (const uint_fast32_t part : seed) {
+    outputfile << "," << part;
+  }
+}
+
+static void writeStatsToFile(const approximation::Result& res,
+                             const ProblemType type,
+                             const std::string& filename,
+                             const double runtime,
+                             const std::array<uint_fast32_t, SEED_LENGTH>& seed) {
   std::ofstream outputfile;
   outputfile.open(filename, std::ios::out | std::ios::app);
   if (!outputfile) {
     throw InvalidFileOperation("Failed to open <" + filename + ">!");
   }
   outputfile << std::to_underlying(type) << ",";
-  outputfile << res.biconnectedGraph.numberOfNodes() << ",";
+  outputfile << res.tour.size() << ",";
   outputfile << res.objective << ",";
   outputfile << res.lowerBoundOnOPT << ",";
   outputfile << res.objective / res.lowerBoundOnOPT << ",";
-  outputfile << res.biconnectedGraph.numberOfEdges() << ",";
+  outputfile << res.numberOfEdgesInBiconnectedGraph << ",";
   outputfile << res.numberOfEdgesInMinimallyBiconectedGraph << ",";
-  outputfile << runtime << std::endl;
+  outputfile << runtime;
+  writeSeedToFile(outputfile, seed);
+  perfcounter::writeToFile(outputfile);
+  outputfile << std::endl;
+}
+
+static void writeStatsToFile(const exactsolver::Result& res,
+                             const ProblemType type,
+                             const std::string& filename,
+                             const double runtime,
+                             const std::array<uint_fast32_t, SEED_LENGTH>& seed) {
+  std::ofstream outputfile;
+  outputfile.open(filename, std::ios::out | std::ios::app);
+  if (!outputfile) {
+    throw InvalidFileOperation("Failed to open <" + filename + ">!");
+  }
+  outputfile << std::to_underlying(type) << ",";
+  outputfile << res.tour.size() << ",";
+  outputfile << res.opt << ",";
+  outputfile << runtime;
+  writeSeedToFile(outputfile, seed);
+  perfcounter::writeToFile(outputfile);
+  outputfile << std::endl;
 }
 
-static void handleApproxOutput(const approximation::Result& res,
-                               const ProblemType type,
-                               const std::string& filename,
-                               const double runtime,
-                               const bool suppressInfo) {
-  if (!suppressInfo) {
+template <typename Result>
+static void handleOutput(const Result& res,
+                         const ProblemType type,
+                         const Settings& settings,
+                         const double runtime,
+                         const std::array<uint_fast32_t, SEED_LENGTH>& seed) {
+  if (!settings.suppressSeed) {
+    printSeed(seed);
+  }
+  if (!settings.suppressInfo) {
     printInfo(res, type, runtime);
   }
-  if (filename.length() > 0) {
-    writeStatsToFile(res, type, filename, runtime);
+  if (settings.filename.length() > 0) {
+    writeStatsToFile(res, type, settings.filename, runtime, seed);
   }
 }
 
-static graph::Euclidean adaptSeededGeneration(const size_t numberOfNodes,
-                                              const std::array<uint_fast32_t, SEED_LENGTH>& seed,
-                                              const bool seeded,
-                                              bool suppressSeed) {
-  if (seeded) {
-    return generateEuclideanDistanceGraph(numberOfNodes, seed, suppressSeed);
+/*!
+ * @brief prints the heap allocations of all instances of one problem type
+ * @param type problem type
+ * @param statistics allocations and bytes summed over all instances, peak bytes is the maximum over all instances
+ * @param numberOfInstances number of instances
+ */
+static void printAllocationReport(const ProblemType type, const allocationtracker::Statistics& statistics, const size_t numberOfInstances) {
+  const bool approximation = type == ProblemType::BTSP_approx || type == ProblemType::BTSPP_approx || type == ProblemType::BTSVPP_approx;
+  std::cout << "-------------------------------------------------------\n";
+  std::cout << "Allocations " << (approximation ? "approximating " : "solving ") << numberOfInstances << " instance(s) of " << type << "."
+            << std::endl;
+  std::cout << "allocations per instance             : " << statistics.allocations / numberOfInstances << std::endl;
+  std::cout << "allocated bytes per instance         : " << statistics.bytes / numberOfInstances << std::endl;
+  std::cout << "peak live bytes                      : " << statistics.peakBytes << std::endl;
+}
+
+/*!
+ * @brief checks the estimated memory of an instance against the memory budget before anything is built
+ * @details Besides the memory of the solver, the double buffered instances are taken into account.
+ * @param numberOfNodes number of nodes in every instance
+ * @param type problem type to solve
+ * @param settings options read from command line
+ * @return true if the instances can be solved within the budget
+ */
+static bool fitsMemoryBudget(const size_t numberOfNodes, const ProblemType type, const Settings& settings) {
+  if (settings.memoryBudget == 0) {
+    return true;
   }
-  else {
-    return generateEuclideanDistanceGraph(numberOfNodes, suppressSeed);
+  const bool approximation = type == ProblemType::BTSP_approx || type == ProblemType::BTSPP_approx || type == ProblemType::BTSVPP_approx;
+  // the positions, the costs of the x variables or the candidate edges alone must fit before the estimate is computed, it could overflow
+  const size_t pairBudget = (approximation ? 2 * (settings.memoryBudget / approximation::BYTES_PER_CANDIDATE_EDGE)
+                                           : settings.memoryBudget / sizeof(double));  // bound of n * (n - 1)
+  const bool exceeded     = numberOfNodes > settings.memoryBudget / (2 * sizeof(graph::Point2D)) ||
+                            (numberOfNodes > 1 && numberOfNodes - 1 > pairBudget / numberOfNodes);
+  if (exceeded) {
+    printYellow("Warning");
+    std::cout << ": Skipped " << type << (approximation ? " approximation" : " exact solver") << ", estimated memory exceeds budget of "
+              << settings.memoryBudget / MEBIBYTE << " MiB." << std::endl;
+    return false;
+  }
+  const size_t estimate = 2 * numberOfNodes * sizeof(graph::Point2D) + (approximation ? approximation::estimateMemory(numberOfNodes, type)
+                                                                                      : exactsolver::estimateMemory(numberOfNodes, type));
+  if (estimate <= settings.memoryBudget) {
+    return true;
+  }
+  printYellow("Warning");
+  std::cout << ": Skipped " << type << (approximation ? " approximation" : " exact solver") << ", estimated memory of "
+            << estimate / MEBIBYTE << " MiB exceeds budget of " << settings.memoryBudget / MEBIBYTE << " MiB." << std::endl;
+  return false;
+}
+
+/*!
+ * @brief builds the filename of the image of one solved instance from the tag of the problem type, the index of the
+ * instance and its seed, e.g. btsp-e_3_42_0.png
+ */
+static std::string imageName(const ProblemType type, const size_t index, const std::array<uint_fast32_t, SEED_LENGTH>& seed) {
+  std::ostringstream name;
+  name << PROBLEM_TYPE_TAGS[std::to_underlying(type)].first.substr(1) << "_" << index;
+  for (const uint_fast32_t part : seed) {
+    name << "_" << part;
+  }
+  name << ".png";
+  return name.str();
+}
+
+/*!
+ * @brief InstanceProducer generates the instances of a SeedSequence in order on one thread of its own
+ * @details The producer hands instances over through two slots, so it generates at most two instances ahead of the
+ * solver. An exception thrown while generating is rethrown by next(). The destructor stops and joins the thread.
+ */
+class InstanceProducer {
+public:
+  InstanceProducer(const size_t numberOfNodes, const SeedSequence& seeds) : pNumberOfNodes(numberOfNodes), pSeeds(seeds) {
+    pThread = std::thread(&InstanceProducer::run, this);
+  }
+
+  ~InstanceProducer() {
+    {
+      std::lock_guard<std::mutex> lock(pMutex);
+      pStop = true;
+    }
+    pSlotFreed.notify_one();
+    pThread.join();
+  }
+
+  InstanceProducer(const InstanceProducer&)            = delete;
+  InstanceProducer& operator=(const InstanceProducer&) = delete;
+
+  /*!
+   * @brief waits for the next instance and takes it from its slot
+   * @details must be called at most seeds.size times
+   */
+  Instance next() {
+    std::unique_lock<std::mutex> lock(pMutex);
+    pSlotFilled.wait(lock, [this] { return pProduced > pConsumed || pError; });
+    if (pProduced == pConsumed) {
+      std::rethrow_exception(pError);
+    }
+    std::optional<Instance>& slot = pSlots[pConsumed++ % pSlots.size()];
+    Instance instance             = std::move(*slot);
+    slot.reset();
+    lock.unlock();
+    pSlotFreed.notify_one();
+    return instance;
+  }
+
+private:
+  void run() {
+    for (size_t i = 0; i < pSeeds.size; ++i) {
+      {
+        std::unique_lock<std::mutex> lock(pMutex);
+        pSlotFreed.wait(lock, [this] { return pStop || pProduced - pConsumed < pSlots.size(); });
+        if (pStop) {
+          return;
+        }
+      }
+      const std::array<uint_fast32_t, SEED_LENGTH> seed = pSeeds[i];
+      try {
+        Instance instance{generateEuclideanDistanceGraph(pNumberOfNodes, seed, true), seed};
+        std::lock_guard<std::mutex> lock(pMutex);
+        pSlots[pProduced++ % pSlots.size()].emplace(std::move(instance));
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(pMutex);
+        pError = std::current_exception();
+      }
+      pSlotFilled.notify_one();
+      if (pError) {
+        return;  // next() rethrows the error, the solver stops there
+      }
+    }
+  }
+
+  const size_t pNumberOfNodes;
+  const SeedSequence pSeeds;
+
+  std::mutex pMutex;
+  std::condition_variable pSlotFreed;
+  std::condition_variable pSlotFilled;
+  std::array<std::optional<Instance>, 2> pSlots; /**< instance i is handed over in slot i % 2 */
+  size_t pProduced = 0;                          /**< number of instances put into a slot */
+  size_t pConsumed = 0;                          /**< number of instances taken from a slot */
+  std::exception_ptr pError;                     /**< set if generating an instance threw */
+  bool pStop = false;
+  std::thread pThread;
+};
+
+/*!
+ * @brief solves one instance per seed in settings and handles the output
+ * @details The instances are generated by an InstanceProducer: while instance i is solved, the following instances are
+ * generated on another thread.
+ * Images of the solutions are handed to the exporter, which renders them on a thread of its own.
+ * @param numberOfNodes number of nodes in every instance
+ * @param type problem type to solve
+ * @param settings options read from command line
+ * @param solver callable that takes a graph::Euclidean and returns a result that can be printed and written to file
+ */
+template <typename Solver>
+static void solveInstances(const size_t numberOfNodes, const ProblemType type, const Settings& settings, Solver solver) {
+  if (settings.seeds.size == 0 || !fitsMemoryBudget(numberOfNodes, type, settings)) {
+    return;
+  }
+  Stopwatch stopWatch;  // create stop watch
+  allocationtracker::Statistics allocations;
+
+  InstanceProducer producer(numberOfNodes, settings.seeds);
+  for (size_t i = 0; i < settings.seeds.size; ++i) {
+    const Instance instance = producer.next();
+    allocationtracker::reset();
+    perfcounter::reset();
+    stopWatch.reset();
+    const auto res                                 = solver(instance.euclidean);
+    const double runtime                           = stopWatch.elapsedTimeInMilliseconds();
+    const allocationtracker::Statistics statistics = allocationtracker::read();
+    handleOutput(res, type, settings, runtime, instance.seed);
+    if (settings.exporter != nullptr) {
+      settings.exporter->submit(imageexport::Solution{instance.euclidean.vertices(), res.tour, res.bottleneckEdge, type},
+                                imageName(type, i, instance.seed));
+    }
+
+    allocations.allocations += statistics.allocations;
+    allocations.bytes       += statistics.bytes;
+    allocations.peakBytes    = std::max(allocations.peakBytes, statistics.peakBytes);
+  }
+  if constexpr (allocationtracker::ENABLED) {
+    printAllocationReport(type, allocations, settings.seeds.size);
+  }
+}
+
+/*!
+ * @brief approximates the problem type on a graph that is already prepared
+ * @param graph complete graph to approximate on
+ * @param type approximation problem type
+ * @param s start of the path for BTSPP
+ * @param t end of the path for BTSPP
+ */
+template <typename G>
+static approximation::Result approximate(const G& graph, const ProblemType type, const size_t s, const size_t t) {
+  switch (type) {
+  case ProblemType::BTSP_approx:
+    return approximation::approximateBTSP<BATCH_RESULT_POLICY>(graph);
+  case ProblemType::BTSPP_approx:
+    return approximation::approximateBTSPP<BATCH_RESULT_POLICY>(graph, s, t);
+  case ProblemType::BTSVPP_approx:
+    return approximation::approximateBTSVPP<BATCH_RESULT_POLICY>(graph);
+  default:
+    throw UnknownType("[COMMAND INTERPRETER] Problem type is not an approximation!");
+  }
+}
+
+/*!
+ * @brief approximates the problem type with the distance given by Metric
+ * @details The graph::Euclidean itself is used for the euclidean metric, so that bottlenecks are found by the vectorised
+ * kernel. If requested, the vertices are renumbered along a Hilbert curve first, s = 0 and t = 1 are renumbered as well.
+ */
+template <typename Metric>
+static approximation::Result approximate(const graph::Euclidean& euclidean, const ProblemType type, const Settings& settings) {
+  const auto solve = [type](const graph::Euclidean& prepared, const size_t s, const size_t t) {
+    if constexpr (std::is_same_v<Metric, metric::Euclidean>) {
+      return approximate(prepared, type, s, t);
+    }
+    else {
+      return approximate(MetricGraph<Metric>(prepared.vertices()), type, s, t);
+    }
+  };
+  if (settings.hilbertOrder) {
+    const hilbertorder::Reordering reordering(euclidean);
+    return reordering.restore(solve(reordering.graph(), reordering.renumbered(0), reordering.renumbered(1)));
+  }
+  return solve(euclidean, 0, 1);
+}
+
+/*!
+ * @brief approximates the problem type with the metric chosen on the command line
+ */
+static approximation::Result approximate(const graph::Euclidean& euclidean, const ProblemType type, const Settings& settings) {
+  switch (settings.metric) {
+  case metric::Type::Euclidean:
+    return approximate<metric::Euclidean>(euclidean, type, settings);
+  case metric::Type::SquaredEuclidean:
+    return approximate<metric::SquaredEuclidean>(euclidean, type, settings);
+  case metric::Type::Manhattan:
+    return approximate<metric::Manhattan>(euclidean, type, settings);
+  case metric::Type::Chebyshev:
+    return approximate<metric::Chebyshev>(euclidean, type, settings);
+  case metric::Type::Haversine:
+    return approximate<metric::Haversine>(euclidean, type, settings);
+  }
+  throw UnknownType("[COMMAND INTERPRETER] Unknown metric!");
+}
+
+/*!
+ * @brief reads the name of a metric
+ * @param argument command line argument starting with METRIC_IDENTIFIER
+ */
+static metric::Type readMetric(const std::string& argument) {
+  const std::string name = argument.substr(METRIC_IDENTIFIER.length());
+  for (const auto& [metricName, type] : METRIC_NAMES) {
+    if (name == metricName) {
+      return type;
+    }
+  }
+  throw InvalidArgument("[COMMAND INTERPRETER] Unknown metric <" + name + ">!");
+}
+
+/*!
+ * @brief reads a memory budget in MiB
+ * @param argument command line argument starting with MEMORY_BUDGET_IDENTIFIER
+ * @return memory budget in bytes
+ */
+static size_t readMemoryBudget(const std::string& argument) {
+  const unsigned long mebibytes = std::stoul(argument.substr(MEMORY_BUDGET_IDENTIFIER.length()));
+  if (mebibytes > SIZE_MAX / MEBIBYTE) {
+    throw InvalidArgument("[COMMAND INTERPRETER] Memory budget <" + std::to_string(mebibytes) + "> MiB exceeds the address space!");
+  }
+  return MEBIBYTE * mebibytes;
+}
+
+/*!
+ * @brief reads one seed of a seed range, the whole text has to be a number that fits into 32 bits
+ * @param text part of the seed range holding the seed
+ * @param range whole seed range for the error message
+ * @return seed
+ */
+static uint_fast32_t readSeed(const std::string_view text, const std::string& range) {
+  uint32_t seed               = 0;
+  const auto [end, errorCode] = std::from_chars(text.data(), text.data() + text.size(), seed);
+  if (errorCode != std::errc() || end != text.data() + text.size()) {
+    throw InvalidArgument("[COMMAND INTERPRETER] Invalid seed range <" + range + ">, <" + std::string(text) +
+                          "> is not a seed between 0 and " + std::to_string(std::numeric_limits<uint32_t>::max()) + "!");
+  }
+  return seed;
+}
+
+/*!
+ * @brief reads a range of seeds in the format <int1>..<int2>
+ * @param argument command line argument starting with SEED_RANGE_IDENTIFIER
+ * @return pair of first and last seed in range
+ */
+static std::pair<uint_fast32_t, uint_fast32_t> readSeedRange(const std::string& argument) {
+  const std::string range = argument.substr(SEED_RANGE_IDENTIFIER.length());
+  const size_t separator  = range.find(SEED_RANGE_SEPARATOR);
+  if (separator == std::string::npos) {
+    throw InvalidArgument("[COMMAND INTERPRETER] Invalid seed range <" + range + ">, expected <int1>" + std::string(SEED_RANGE_SEPARATOR) +
+                          "<int2>!");
+  }
+  const std::string_view text = range;
+  const uint_fast32_t first   = readSeed(text.substr(0, separator), range);
+  const uint_fast32_t last    = readSeed(text.substr(separator + SEED_RANGE_SEPARATOR.length()), range);
+  if (first > last) {
+    throw InvalidArgument("[COMMAND INTERPRETER] Invalid seed range <" + range + ">, first seed " + std::to_string(first) +
+                          " is greater than last seed " + std::to_string(last) + "!");
   }
+  return std::make_pair(first, last);
+}
+
+/*!
+ * @brief describes the seeds of all instances to solve
+ * @details A seed range takes precedence over a fixed seed. Within a range the first part of the seed is iterated, while
+ * the remaining parts are 0, so that every instance can be replayed with <-seed> <int> 0 ... . Without a seed the first
+ * part of one random seed is iterated.
+ */
+static SeedSequence seedSequence(const size_t repetitions,
+                                 const std::array<uint_fast32_t, SEED_LENGTH>& seed,
+                                 const bool seeded,
+                                 const std::pair<uint_fast32_t, uint_fast32_t>& seedRange,
+                                 const bool ranged) {
+  if (ranged) {
+    const size_t width = std::min<uintmax_t>(seedRange.second - seedRange.first, SIZE_MAX - 1);  // avoid overflow of the size
+    SeedSequence seeds{.size = width + 1, .first = {}, .fixed = false};
+    seeds.first[0] = seedRange.first;
+    return seeds;
+  }
+  if (seeded) {
+    return SeedSequence{.size = repetitions, .first = seed, .fixed = true};
+  }
+  return SeedSequence{.size = repetitions, .first = generateSeed(), .fixed = false};
 }
 
 static void readArguments(const int argc, char* argv[]) {
-  std::string filename = "";
-  size_t repetitions   = 1;
-  bool suppressInfo = false, suppressSeed = false;
+  Settings settings;
+  size_t repetitions = 1;
   std::unordered_set<std::string> arguments;
-  bool seeded = false;
+  bool seeded = false, ranged = false;
   std::array<uint_fast32_t, SEED_LENGTH> seed;
+  std::pair<uint_fast32_t, uint_fast32_t> seedRange;
   for (int i = 2; i < argc; ++i) {
     if (findSeed(seed, argv, i)) {
       seeded = true;
       continue;
     }
     if (std::string(argv[i]).starts_with(LOG_FILE_IDENTIFIER)) {
-      filename = std::string(argv[i]).substr(LOG_FILE_IDENTIFIER.length(), std::string(argv[i]).length() - LOG_FILE_IDENTIFIER.length());
+      settings.filename =
+          std::string(argv[i]).substr(LOG_FILE_IDENTIFIER.length(), std::string(argv[i]).length() - LOG_FILE_IDENTIFIER.length());
       continue;
     }
     if (std::string(argv[i]).starts_with(REPETITION_IDENTIFIER)) {
@@ -192,12 +667,33 @@ static void readArguments(const int argc, char* argv[]) {
           std::string(argv[i]).substr(REPETITION_IDENTIFIER.length(), std::string(argv[i]).length() - REPETITION_IDENTIFIER.length()));
       continue;
     }
+    if (std::string(argv[i]).starts_with(SEED_RANGE_IDENTIFIER)) {
+      seedRange = readSeedRange(std::string(argv[i]));
+      ranged    = true;
+      continue;
+    }
+    if (std::string(argv[i]).starts_with(MEMORY_BUDGET_IDENTIFIER)) {
+      settings.memoryBudget = readMemoryBudget(std::string(argv[i]));
+      continue;
+    }
+    if (std::string(argv[i]).starts_with(EXPORT_PNG_IDENTIFIER)) {
+      settings.imageDirectory = std::string(argv[i]).substr(EXPORT_PNG_IDENTIFIER.length());
+      continue;
+    }
+    if (std::string(argv[i]).starts_with(METRIC_IDENTIFIER)) {
+      settings.metric = readMetric(std::string(argv[i]));
+      continue;
+    }
+    if (std::string(argv[i]) == HILBERT_ORDER_TAG) {
+      settings.hilbertOrder = true;
+      continue;
+    }
     if (std::string(argv[i]) == SUPPRESS_INFO_TAG) {
-      suppressInfo = true;
+      settings.suppressInfo = true;
       continue;
     }
     if (std::string(argv[i]) == SUPPRESS_SEED_TAG) {
-      suppressSeed = true;
+      settings.suppressSeed = true;
       continue;
     }
     arguments.insert(std::string(argv[i]));
@@ -207,69 +703,69 @@ static void readArguments(const int argc, char* argv[]) {
     printYellow("Warning");
     std::cout << ": No problem type given. Nothing to do." << std::endl;
   }
+  if (ranged && seeded) {
+    printYellow("Warning");
+    std::cout << ": Seed range is given, ignoring <-seed>." << std::endl;
+  }
+  if (ranged && repetitions != 1) {
+    printYellow("Warning");
+    std::cout << ": Seed range is given, ignoring <" << REPETITION_IDENTIFIER << ">." << std::endl;
+  }
 
-  Stopwatch stopWatch;  // create stop watch
+  settings.seeds             = seedSequence(repetitions, seed, seeded, seedRange, ranged);
+  const size_t numberOfNodes = std::atoi(argv[1]);
 
-  if (arguments.contains(std::string(BTSP_APPROX_TAG))) {
-    for (size_t i = 0; i < repetitions; ++i) {
-      graph::Euclidean euclidean = adaptSeededGeneration(std::atoi(argv[1]), seed, seeded, suppressSeed);
-      stopWatch.reset();
-      const approximation::Result res = approximation::approximateBTSP(euclidean);
-      const double runtime            = stopWatch.elapsedTimeInMilliseconds();
-      handleApproxOutput(res, ProblemType::BTSP_approx, filename, runtime, suppressInfo);
-    }
-    arguments.erase(std::string(BTSP_APPROX_TAG));
-  }
-  if (arguments.contains(std::string(BTSPP_APPROX_TAG))) {
-    for (size_t i = 0; i < repetitions; ++i) {
-      graph::Euclidean euclidean = adaptSeededGeneration(std::atoi(argv[1]), seed, seeded, suppressSeed);
-      stopWatch.reset();
-      const approximation::Result res = approximation::approximateBTSPP(euclidean);
-      const double runtime            = stopWatch.elapsedTimeInMilliseconds();
-      handleApproxOutput(res, ProblemType::BTSPP_approx, filename, runtime, suppressInfo);
-    }
-    arguments.erase(std::string(BTSPP_APPROX_TAG));
-  }
-  if (arguments.contains(std::string(BTSVPP_APPROX_TAG))) {
-    for (size_t i = 0; i < repetitions; ++i) {
-      graph::Euclidean euclidean = adaptSeededGeneration(std::atoi(argv[1]), seed, seeded, suppressSeed);
-      stopWatch.reset();
-      const approximation::Result res = approximation::approximateBTSVPP(euclidean);
-      const double runtime            = stopWatch.elapsedTimeInMilliseconds();
-      handleApproxOutput(res, ProblemType::BTSVPP_approx, filename, runtime, suppressInfo);
+  std::optional<imageexport::Exporter> exporter;  // outlives all problem types, so that rendering overlaps solving
+  if (!settings.imageDirectory.empty()) {
+    exporter.emplace(settings.imageDirectory, IMAGE_SIZE, IMAGE_SIZE);
+    settings.exporter = &*exporter;
+  }
+
+  if (settings.metric != metric::Type::Euclidean &&
+      (arguments.contains(std::string(BTSP_EXACT_TAG)) || arguments.contains(std::string(BTSPP_EXACT_TAG)) ||
+       arguments.contains(std::string(TSP_EXACT_TAG)))) {
+    printYellow("Warning");
+    std::cout << ": <" << METRIC_IDENTIFIER << "> applies to approximations only, exact solutions use euclidean distances." << std::endl;
+  }
+
+  for (const ProblemType type : {ProblemType::BTSP_approx, ProblemType::BTSPP_approx, ProblemType::BTSVPP_approx}) {
+    const std::string tag(PROBLEM_TYPE_TAGS[std::to_underlying(type)].first);
+    if (arguments.contains(tag)) {
+      solveInstances(numberOfNodes, type, settings, [type, &settings](const graph::Euclidean& euclidean) {
+        return approximate(euclidean, type, settings);
+      });
+      arguments.erase(tag);
     }
-    arguments.erase(std::string(BTSVPP_APPROX_TAG));
   }
   if (arguments.contains(std::string(BTSP_EXACT_TAG))) {
-    graph::Euclidean euclidean = adaptSeededGeneration(std::atoi(argv[1]), seed, seeded, suppressSeed);
-    stopWatch.reset();
-    const exactsolver::Result res =
-        exactsolver::solve(euclidean, ProblemType::BTSP_exact, arguments.contains(std::string(NO_CROSSING_TAG)));
-    const double runtime = stopWatch.elapsedTimeInMilliseconds();
-    printInfo(res, ProblemType::BTSP_exact, runtime);
+    const bool noCrossing = arguments.contains(std::string(NO_CROSSING_TAG));
+    solveInstances(numberOfNodes, ProblemType::BTSP_exact, settings, [noCrossing](const graph::Euclidean& euclidean) {
+      return exactsolver::solve(euclidean, ProblemType::BTSP_exact, noCrossing);
+    });
     arguments.erase(std::string(BTSP_EXACT_TAG));
     arguments.erase(std::string(NO_CROSSING_TAG));
   }
   if (arguments.contains(std::string(BTSPP_EXACT_TAG))) {
-    graph::Euclidean euclidean = adaptSeededGeneration(std::atoi(argv[1]), seed, seeded, suppressSeed);
-    stopWatch.reset();
-    const exactsolver::Result res = exactsolver::solve(euclidean, ProblemType::BTSPP_exact);
-    const double runtime          = stopWatch.elapsedTimeInMilliseconds();
-    printInfo(res, ProblemType::BTSPP_exact, runtime);
+    solveInstances(numberOfNodes, ProblemType::BTSPP_exact, settings, [](const graph::Euclidean& euclidean) {
+      return exactsolver::solve(euclidean, ProblemType::BTSPP_exact);
+    });
     arguments.erase(std::string(BTSPP_EXACT_TAG));
   }
   if (arguments.contains(std::string(TSP_EXACT_TAG))) {
-    graph::Euclidean euclidean = adaptSeededGeneration(std::atoi(argv[1]), seed, seeded, suppressSeed);
-    stopWatch.reset();
-    const exactsolver::Result res = exactsolver::solve(euclidean, ProblemType::TSP_exact);
-    const double runtime          = stopWatch.elapsedTimeInMilliseconds();
-    printInfo(res, ProblemType::TSP_exact, runtime);
+    solveInstances(numberOfNodes, ProblemType::TSP_exact, settings, [](const graph::Euclidean& euclidean) {
+      return exactsolver::solve(euclidean, ProblemType::TSP_exact);
+    });
     arguments.erase(std::string(TSP_EXACT_TAG));
   }
 
-  if (filename.length() > 0) {
+  if (settings.filename.length() > 0) {
     printLightgreen("Info");
-    std::cout << ": Output has been written to <" << filename << ">.\n";
+    std::cout << ": Output has been written to <" << settings.filename << ">.\n";
+  }
+  if (exporter) {
+    exporter.reset();  // waits for the remaining images
+    printLightgreen("Info");
+    std::cout << ": Images have been written to <" << settings.imageDirectory << ">.\n";
   }
   for (const std::string& str : arguments) {
     printYellow("Warning");
@@ -277,6 +773,138 @@ static void readArguments(const int argc, char* argv[]) {
   }
 }
 
+/*!
+ * @brief runs the solver as a service reading instances from stdin and writing solutions to stdout
+ * @details Nothing but solutions is written to stdout, so invalid arguments are reported by exceptions only.
+ * @param argc number of arguments as passed to main
+ * @param argv argument list as passed to main, argv[1] is SERVICE_KEYWORD
+ */
+static void runService(const int argc, char* argv[]) {
+  std::unordered_set<std::string> arguments(argv + 2, argv + argc);
+  const service::Format format = (arguments.erase(std::string(BINARY_INPUT_TAG)) > 0 ? service::Format::Binary : service::Format::Text);
+  const bool noCrossing        = arguments.erase(std::string(NO_CROSSING_TAG)) > 0;
+  size_t memoryBudget          = 0;
+  const auto budgetArgument    = std::ranges::find_if(arguments, [](const std::string& argument) {
+    return argument.starts_with(MEMORY_BUDGET_IDENTIFIER);
+  });
+  if (budgetArgument != arguments.end()) {
+    memoryBudget = readMemoryBudget(*budgetArgument);
+    arguments.erase(budgetArgument);
+  }
+
+  std::vector<ProblemType> types;
+  for (const auto& [tag, type] : PROBLEM_TYPE_TAGS) {
+    if (arguments.erase(std::string(tag)) > 0) {
+      types.push_back(type);
+    }
+  }
+  if (!arguments.empty()) {
+    throw InvalidArgument("[COMMAND INTERPRETER] Unknown argument <" + *arguments.begin() + "> for service!");
+  }
+  if (types.empty()) {
+    throw InvalidArgument("[COMMAND INTERPRETER] No problem type given for service!");
+  }
+  service::serve(types, format, noCrossing, memoryBudget);
+}
+
+static bool isApproximation(const ProblemType type) {
+  return type == ProblemType::BTSP_approx || type == ProblemType::BTSPP_approx || type == ProblemType::BTSVPP_approx;
+}
+
+/*!
+ * @brief solves every problem type once on a graph given by a distance matrix
+ * @param matrix complete graph given by a distance matrix
+ * @param types problem types to solve
+ * @param settings options read from command line, seeds are not used
+ */
+template <typename Entry>
+static void solveMatrix(const DistanceMatrix<Entry>& matrix, const std::vector<ProblemType>& types, const Settings& settings) {
+  const std::array<uint_fast32_t, SEED_LENGTH> seed{};  // matrices are not generated, the seed columns of the logfile are 0
+  Stopwatch stopWatch;
+  for (const ProblemType type : types) {
+    perfcounter::reset();
+    stopWatch.reset();
+    if (isApproximation(type)) {
+      const approximation::Result res = approximate(matrix, type, 0, 1);
+      handleOutput(res, type, settings, stopWatch.elapsedTimeInMilliseconds(), seed);
+    }
+    else {
+      const exactsolver::Result res = exactsolver::solve(matrix, type);
+      handleOutput(res, type, settings, stopWatch.elapsedTimeInMilliseconds(), seed);
+    }
+  }
+}
+
+/*!
+ * @brief reads a distance matrix from file and solves the given problem types on it
+ * @param argc number of arguments as passed to main
+ * @param argv argument list as passed to main, argv[1] is MATRIX_KEYWORD and argv[2] the file
+ */
+static void runMatrix(const int argc, char* argv[]) {
+  if (argc < 3) {
+    throw InvalidArgument("[COMMAND INTERPRETER] No file given for <" + std::string(MATRIX_KEYWORD) + ">!");
+  }
+  const std::string matrixFile(argv[2]);
+  std::unordered_set<std::string> arguments(argv + 3, argv + argc);
+  const bool quantised     = arguments.erase(std::string(QUANTISED_TAG)) > 0;
+  const bool rankTransform = arguments.erase(std::string(RANK_TRANSFORM_TAG)) > 0;
+
+  Settings settings;
+  settings.suppressSeed = true;
+  settings.suppressInfo = arguments.erase(std::string(SUPPRESS_INFO_TAG)) > 0;
+  const auto logFileArgument = std::ranges::find_if(arguments, [](const std::string& argument) {
+    return argument.starts_with(LOG_FILE_IDENTIFIER);
+  });
+  if (logFileArgument != arguments.end()) {
+    settings.filename = logFileArgument->substr(LOG_FILE_IDENTIFIER.length());
+    arguments.erase(logFileArgument);
+  }
+
+  std::vector<ProblemType> types;
+  for (const auto& [tag, type] : PROBLEM_TYPE_TAGS) {
+    if (arguments.erase(std::string(tag)) > 0) {
+      types.push_back(type);
+    }
+  }
+  if (!arguments.empty()) {
+    throw InvalidArgument("[COMMAND INTERPRETER] Unknown argument <" + *arguments.begin() + "> for distance matrices!");
+  }
+  if (types.empty()) {
+    printYellow("Warning");
+    std::cout << ": No problem type given. Nothing to do." << std::endl;
+    return;
+  }
+  if (rankTransform && std::ranges::find(types, ProblemType::TSP_exact) != types.end()) {
+    throw InvalidArgument("[COMMAND INTERPRETER] <" + std::string(RANK_TRANSFORM_TAG) + "> keeps only the order of the distances, <" +
+                          std::string(TSP_EXACT_TAG) + "> would minimise a sum of ranks!");
+  }
+  if (std::ranges::any_of(types, isApproximation)) {
+    printYellow("Warning");
+    std::cout << ": The triangle inequality isn't checked, approximations are only within factor 2 if the matrix satisfies it."
+              << std::endl;
+  }
+
+  if (quantised) {
+    solveMatrix(readDistanceMatrix<uint16_t>(matrixFile, rankTransform), types, settings);
+  }
+  else {
+    solveMatrix(readDistanceMatrix<float>(matrixFile, rankTransform), types, settings);
+  }
+}
+
+static void printMatrixAdvice() {
+  std::cout << "./<NameOfExecutable> " << MATRIX_KEYWORD << " <filename> <arg1> <arg2> ... to solve the instance in <filename>.\n";
+  std::cout << "The file contains the number of nodes n followed by the symmetric n x n matrix. Pass <" << QUANTISED_TAG
+            << "> to store the distances in 16 bit and <" << RANK_TRANSFORM_TAG << "> to replace them by their ranks.\n";
+}
+
+static void printServiceAdvice() {
+  std::cout << "./<NameOfExecutable> " << SERVICE_KEYWORD << " <arg1> <arg2> ... to read instances from stdin until end of file.\n";
+  std::cout << "Every instance is the number of nodes followed by x and y of every node. Pass <" << BINARY_INPUT_TAG
+            << "> to read the number as uint64_t and the coordinates as double instead of text.\n";
+  std::cout << "<" << MEMORY_BUDGET_IDENTIFIER << "<MiB>> skips instances whose estimated memory exceeds <MiB>.\n";
+}
+
 static void printArgumentList() {
   std::cout << "Valid command line arguments are: \n";
   std::cout << "<" << BTSP_APPROX_TAG << "> to approximate BTSP\n";
@@ -293,6 +921,16 @@ void interpretCommandLine(const int argc, char* argv[]) {
     printArgumentList();
     printSeedAdvice();
     printAdvices();
+    printServiceAdvice();
+    printMatrixAdvice();
+    return;
+  }
+  if (argc >= 2 && std::string(argv[1]) == SERVICE_KEYWORD) {
+    runService(argc, argv);
+    return;
+  }
+  if (argc >= 2 && std::string(argv[1]) == MATRIX_KEYWORD) {
+    runMatrix(argc, argv);
     return;
   }
   if (argc < 3) {
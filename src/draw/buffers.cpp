@@ -18,7 +18,12 @@
  */
 #include "draw/buffers.hpp"
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 template <>
 VertexBuffer::VertexBuffer(const std::vector<float>& dat, const GLuint componentsPerVertex) :
@@ -47,3 +52,58 @@ void VertexArray::bindBufferBase(const std::shared_ptr<ShaderBuffer> shaderBuffe
   this->bind();
   GL_CALL(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindingPoint, shaderBuffer->id());)
 }
+
+TourBuffer::TourBuffer(const size_t capacity, const size_t numberOfRegions) :
+  pCapacity(capacity),
+  pDisplayedSlot(numberOfRegions, 0),
+  pSize(numberOfRegions, 0),
+  pFences(SLOTS_PER_REGION * numberOfRegions, nullptr) {
+  GLint alignment;
+  GL_CALL(glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);)
+  pSlotStride = (capacity * sizeof(uint32_t) + alignment - 1) / alignment * alignment;
+
+  const GLsizeiptr bytes  = pSlotStride * SLOTS_PER_REGION * numberOfRegions;
+  const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  GL_CALL(glGenBuffers(1, &pID);)
+  GL_CALL(glBindBuffer(GL_SHADER_STORAGE_BUFFER, pID);)
+  GL_CALL(glBufferStorage(GL_SHADER_STORAGE_BUFFER, bytes, nullptr, access);)
+  GL_CALL(pMapped = static_cast<std::byte*>(glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, bytes, access));)
+}
+
+TourBuffer::~TourBuffer() {
+  for (const GLsync fence : pFences) {
+    if (fence != nullptr) {
+      GL_CALL(glDeleteSync(fence);)
+    }
+  }
+  GL_CALL(glBindBuffer(GL_SHADER_STORAGE_BUFFER, pID);)
+  GL_CALL(glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);)
+  GL_CALL(glDeleteBuffers(1, &pID);)
+}
+
+void TourBuffer::write(const size_t region, const std::vector<uint32_t>& order) {
+  assert(order.size() <= pCapacity && "tour exceeds the capacity of the buffer");
+  const size_t back = 1 - pDisplayedSlot[region];
+  GLsync& fence     = pFences[slot(region, back)];
+  if (fence != nullptr) {  // wait until the GPU finished the last draw reading this slot
+    GL_CALL(glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);)
+    GL_CALL(glDeleteSync(fence);)
+    fence = nullptr;
+  }
+  std::memcpy(pMapped + slot(region, back) * pSlotStride, order.data(), bytes_of(order));
+  pDisplayedSlot[region] = back;
+  pSize[region]          = order.size();
+}
+
+void TourBuffer::bindRange(const size_t region, const GLuint bindingPoint) const {
+  const GLintptr offset = slot(region, pDisplayedSlot[region]) * pSlotStride;
+  GL_CALL(glBindBufferRange(GL_SHADER_STORAGE_BUFFER, bindingPoint, pID, offset, pCapacity * sizeof(uint32_t));)
+}
+
+void TourBuffer::fence(const size_t region) {
+  GLsync& fence = pFences[slot(region, pDisplayedSlot[region])];
+  if (fence != nullptr) {
+    GL_CALL(glDeleteSync(fence);)
+  }
+  GL_CALL(fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);)
+}
@@ -35,10 +35,6 @@
 #include "graph.hpp"
 
 namespace drawing {
-static RGBA_COLOUR operator*(const RGBA_COLOUR& colour, const float fade) {
-  return RGBA_COLOUR{colour[0] * fade, colour[1] * fade, colour[2] * fade, colour[3]};
-}
-
 static void clearWindow(GLFWwindow* window, const RGBA_COLOUR& clearColour) {
   int display_w, display_h;
   glfwGetFramebufferSize(window, &display_w, &display_h);
@@ -48,184 +44,139 @@ static void clearWindow(GLFWwindow* window, const RGBA_COLOUR& clearColour) {
 }
 
 // the vertex buffer object needs to be bound and the attribute vertex_position needs to be enabled
-static void drawVertices(const ShaderProgram& drawCircles, const size_t numberOfVertices, const RGBA_COLOUR& vertexColour) {
+static void drawVertices(const ShaderProgramCollection& programs,
+                         const size_t numberOfVertices,
+                         const RGBA_COLOUR& vertexColour,
+                         const LevelOfDetail& levelOfDetail,
+                         ElementBuffer& representatives) {
+  const ShaderProgram& drawCircles = programs.drawCircles;
   drawCircles.use();  // need to call glUseProgram before setting uniforms
-  drawCircles.setUniform("u_steps", CIRCLE_STEPS);
-  drawCircles.setUniform("u_radius", VETREX_RADIUS);
-  drawCircles.setUniform("u_colour", vertexColour);
+  drawCircles.setUniform(programs.circleSteps, CIRCLE_STEPS);
+  drawCircles.setUniform(programs.circleRadius, VETREX_RADIUS);
+  drawCircles.setUniform(programs.circleColour, vertexColour);
 
-  glDrawArrays(GL_POINTS, 0, numberOfVertices);  // start at index 0
+  if (levelOfDetail.active()) {  // one circle per density tile
+    representatives.bind();
+    glDrawElements(GL_POINTS, representatives.size(), GL_UNSIGNED_INT, nullptr);
+  }
+  else {
+    glDrawArrays(GL_POINTS, 0, numberOfVertices);  // start at index 0
+  }
 }
 
-static void drawPath(const ShaderProgram& drawPathSegments,
-                     const std::shared_ptr<ShaderBuffer> shaderBuffer,
-                     const std::vector<uint32_t>& order,
-                     const float thickness,
-                     const RGBA_COLOUR& colour) {
-  shaderBuffer->bufferSubData(order);
-  drawPathSegments.use();
-  drawPathSegments.setUniform("u_thickness", thickness);
-  drawPathSegments.setUniform("u_resolution", mainwindow::WIDTH, mainwindow::HEIGHT);
-  drawPathSegments.setUniform("u_colour", colour);
+// draws the vertex under the cursor again, larger and in the highlight colour
+static void drawHoveredVertex(const ShaderProgramCollection& programs, const int vertex) {
+  if (vertex == namedInts::INVALID) {
+    return;
+  }
+  const ShaderProgram& drawCircles = programs.drawCircles;
+  drawCircles.use();
+  drawCircles.setUniform(programs.circleRadius, VETREX_RADIUS * HOVER_RADIUS_FACTOR);
+  drawCircles.setUniform(programs.circleColour, HOVER_VERTEX_COLOUR);
+
+  glDrawArrays(GL_POINTS, vertex, 1);
+}
+
+static void drawPath(const ShaderProgramCollection& programs, TourBuffer& tours, const ProblemType type) {
+  tours.bindRange(std::to_underlying(type), TOUR_BINDING_POINT);
+  programs.drawPathSegments.use();
+  programs.drawPathSegments.setUniform(programs.pathSegmentType, static_cast<int>(std::to_underlying(type)));
 
   glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-  glDrawArrays(GL_TRIANGLES, 0, 6 * (order.size() - PATH_OVERHEAD));
+  glDrawArrays(GL_TRIANGLES, 0, 6 * (tours.size(std::to_underlying(type)) - PATH_OVERHEAD));
+  tours.fence(std::to_underlying(type));
 }
 
-static void drawEdge(const ShaderProgram& drawLine,
+// draws the bottleneck edge of a solution, wider than the edges in the path
+static void drawEdge(const ShaderProgramCollection& programs,
                      const FloatVertices& floatVertices,
                      const graph::Edge& e,
-                     const float thickness,
-                     const RGBA_COLOUR& colour) {
+                     const ProblemType type) {
+  const ShaderProgram& drawLine = programs.drawLine;
   drawLine.use();
-  drawLine.setUniform("u_ends", floatVertices.xCoord(e.u), floatVertices.yCoord(e.u), floatVertices.xCoord(e.v), floatVertices.yCoord(e.v));
-  drawLine.setUniform("u_thickness", thickness);
-  drawLine.setUniform("u_resolution", mainwindow::WIDTH, mainwindow::HEIGHT);
-  drawLine.setUniform("u_colour", colour);
+  drawLine.setUniform(
+    programs.lineEnds, floatVertices.xCoord(e.u), floatVertices.yCoord(e.u), floatVertices.xCoord(e.v), floatVertices.yCoord(e.v));
+  drawLine.setUniform(programs.lineType, static_cast<int>(std::to_underlying(type)));
+  drawLine.setUniform(programs.lineThicknessFactor, BOTLLENECK_EDGE_WIDTH_FACTOR);
 
   glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
   glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
-template <typename G>
-static void drawGraph(const ShaderProgram& drawLine,
-                      const FloatVertices& floatVertices,
-                      const G& graph,
-                      const float thickness,
-                      const RGBA_COLOUR& colour) {
-  for (const graph::Edge& e : graph.edges()) {
-    drawEdge(drawLine, floatVertices, e, thickness, colour);
+// draws all edges in edgeList with a single instanced draw call, the vertex coordinates are read from binding point 0
+static void drawEdges(const ShaderProgramCollection& programs, const EdgeList& edgeList, const ProblemType type) {
+  if (edgeList.size() == 0) {
+    return;
   }
-}
+  edgeList.bindBase(EDGE_LIST_BINDING_POINT);
+  programs.drawEdges.use();
+  programs.drawEdges.setUniform(programs.edgeType, static_cast<int>(std::to_underlying(type)));
 
-static void drawOpenEarDecomposition(const ShaderProgram& drawLine,
-                                     const std::shared_ptr<DrawData> drawData,
-                                     const graph::EarDecomposition& openEarDecomp) {
-  for (size_t i = 0; i < openEarDecomp.ears.size(); ++i) {
-    const std::vector<size_t>& chain = openEarDecomp.ears[i];
-    RGBA_COLOUR colour =
-        drawData->appearance.colour[std::to_underlying(ProblemType::BTSP_approx)] * ((float) i / (openEarDecomp.ears.size() - 1));
-    for (size_t j = chain.size() - 1; j > 0; --j) {
-      drawEdge(drawLine,
-               drawData->floatVertices,
-               graph::Edge{chain[j], chain[j - 1]},
-               drawData->appearance.thickness[std::to_underlying(ProblemType::BTSP_approx)],
-               colour);
-    }
-  }
+  glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+  glDrawArraysInstanced(GL_TRIANGLES, 0, 6, edgeList.size());
 }
 
 void draw(GLFWwindow* window, const ShaderProgramCollection& programs, const std::shared_ptr<DrawData> drawData) {
+  drawData->appearanceUniforms.update(drawData->appearance, mainwindow::WIDTH, mainwindow::HEIGHT, CAMERA);
   clearWindow(window, drawData->appearance.clearColour);
-  drawVertices(programs.drawCircles, EUCLIDEAN.numberOfNodes(), drawData->appearance.vertexColour);
+  drawVertices(programs,
+               EUCLIDEAN.numberOfNodes(),
+               drawData->appearance.vertexColour,
+               drawData->levelOfDetail,
+               *drawData->buffers.representatives);
+  drawHoveredVertex(programs, input::mouse::NODE_HOVERED);
 
   // BTSP approx
   unsigned int typeInt = std::to_underlying(ProblemType::BTSP_approx);
   if (BTSP_DRAW_BICONNECTED_GRAPH && ACTIVE[typeInt] && drawData->vertexOrder.initialized(ProblemType::BTSP_approx)) {
-    drawGraph(programs.drawLine,
-              drawData->floatVertices,
-              drawData->results.BTSP_APPROX_RESULT.biconnectedGraph,
-              drawData->appearance.thickness[typeInt],
-              drawData->appearance.colour[typeInt]);
+    drawEdges(programs, drawData->edgeLists.BTSP_BICONNECTED_GRAPH, ProblemType::BTSP_approx);
   }
   if (BTSP_DRAW_OPEN_EAR_DECOMPOSITION && ACTIVE[typeInt] && drawData->vertexOrder.initialized(ProblemType::BTSP_approx)) {
-    drawOpenEarDecomposition(programs.drawLine, drawData, drawData->results.BTSP_APPROX_RESULT.openEarDecomposition);
+    drawEdges(programs, drawData->edgeLists.BTSP_OPEN_EAR_DECOMPOSITION, ProblemType::BTSP_approx);
   }
   if (BTSP_DRAW_HAMILTON_CYCLE && ACTIVE[typeInt] && drawData->vertexOrder.initialized(ProblemType::BTSP_approx)) {
-    drawPath(programs.drawPathSegments,
-             drawData->buffers.tour,
-             drawData->vertexOrder[ProblemType::BTSP_approx],
-             drawData->appearance.thickness[typeInt],
-             drawData->appearance.colour[typeInt]);
-    drawEdge(programs.drawLine,
-             drawData->floatVertices,
-             drawData->results.BTSP_APPROX_RESULT.bottleneckEdge,
-             drawData->appearance.thickness[typeInt] * BOTLLENECK_EDGE_WIDTH_FACTOR,
-             drawData->appearance.colour[typeInt]);
+    drawPath(programs, *drawData->buffers.tours, ProblemType::BTSP_approx);
+    drawEdge(programs, drawData->floatVertices, drawData->results.BTSP_APPROX_RESULT.bottleneckEdge, ProblemType::BTSP_approx);
   }
 
   // BTSPP approx
   typeInt = std::to_underlying(ProblemType::BTSPP_approx);
   if (BTSPP_DRAW_BICONNECTED_GRAPH && ACTIVE[typeInt] && drawData->vertexOrder.initialized(ProblemType::BTSPP_approx)) {
-    drawGraph(programs.drawLine,
-              drawData->floatVertices,
-              drawData->results.BTSPP_APPROX_RESULT.biconnectedGraph,
-              drawData->appearance.thickness[typeInt],
-              drawData->appearance.colour[typeInt]);
+    drawEdges(programs, drawData->edgeLists.BTSPP_BICONNECTED_GRAPH, ProblemType::BTSPP_approx);
   }
   if (BTSPP_DRAW_HAMILTON_PATH && ACTIVE[typeInt] && drawData->vertexOrder.initialized(ProblemType::BTSPP_approx)) {
-    drawPath(programs.drawPathSegments,
-             drawData->buffers.tour,
-             drawData->vertexOrder[ProblemType::BTSPP_approx],
-             drawData->appearance.thickness[typeInt],
-             drawData->appearance.colour[typeInt]);
-    drawEdge(programs.drawLine,
-             drawData->floatVertices,
-             drawData->results.BTSPP_APPROX_RESULT.bottleneckEdge,
-             drawData->appearance.thickness[typeInt] * BOTLLENECK_EDGE_WIDTH_FACTOR,
-             drawData->appearance.colour[typeInt]);
+    drawPath(programs, *drawData->buffers.tours, ProblemType::BTSPP_approx);
+    drawEdge(programs, drawData->floatVertices, drawData->results.BTSPP_APPROX_RESULT.bottleneckEdge, ProblemType::BTSPP_approx);
   }
 
   // BTSVPP approx
   typeInt = std::to_underlying(ProblemType::BTSVPP_approx);
   if (BTSVPP_DRAW_BICONNECTED_GRAPH && ACTIVE[typeInt] && drawData->vertexOrder.initialized(ProblemType::BTSVPP_approx)) {
-    drawGraph(programs.drawLine,
-              drawData->floatVertices,
-              drawData->results.BTSVPP_APPROX_RESULT.biconnectedGraph,
-              drawData->appearance.thickness[typeInt],
-              drawData->appearance.colour[typeInt]);
+    drawEdges(programs, drawData->edgeLists.BTSVPP_BICONNECTED_GRAPH, ProblemType::BTSVPP_approx);
   }
   if (BTSVPP_DRAW_HAMILTON_PATH && ACTIVE[typeInt] && drawData->vertexOrder.initialized(ProblemType::BTSVPP_approx)) {
-    drawPath(programs.drawPathSegments,
-             drawData->buffers.tour,
-             drawData->vertexOrder[ProblemType::BTSVPP_approx],
-             drawData->appearance.thickness[typeInt],
-             drawData->appearance.colour[typeInt]);
-    drawEdge(programs.drawLine,
-             drawData->floatVertices,
-             drawData->results.BTSVPP_APPROX_RESULT.bottleneckEdge,
-             drawData->appearance.thickness[typeInt] * BOTLLENECK_EDGE_WIDTH_FACTOR,
-             drawData->appearance.colour[typeInt]);
+    drawPath(programs, *drawData->buffers.tours, ProblemType::BTSVPP_approx);
+    drawEdge(programs, drawData->floatVertices, drawData->results.BTSVPP_APPROX_RESULT.bottleneckEdge, ProblemType::BTSVPP_approx);
   }
 
   // BTSP exact
   typeInt = std::to_underlying(ProblemType::BTSP_exact);
   if (ACTIVE[typeInt] && drawData->vertexOrder.initialized(ProblemType::BTSP_exact)) {
-    drawPath(programs.drawPathSegments,
-             drawData->buffers.tour,
-             drawData->vertexOrder[ProblemType::BTSP_exact],
-             drawData->appearance.thickness[typeInt],
-             drawData->appearance.colour[typeInt]);
-    drawEdge(programs.drawLine,
-             drawData->floatVertices,
-             drawData->results.BTSP_EXACT_RESULT.bottleneckEdge,
-             drawData->appearance.thickness[typeInt] * BOTLLENECK_EDGE_WIDTH_FACTOR,
-             drawData->appearance.colour[typeInt]);
+    drawPath(programs, *drawData->buffers.tours, ProblemType::BTSP_exact);
+    drawEdge(programs, drawData->floatVertices, drawData->results.BTSP_EXACT_RESULT.bottleneckEdge, ProblemType::BTSP_exact);
   }
 
   // BTSPP exact
   typeInt = std::to_underlying(ProblemType::BTSPP_exact);
   if (ACTIVE[typeInt] && drawData->vertexOrder.initialized(ProblemType::BTSPP_exact)) {
-    drawPath(programs.drawPathSegments,
-             drawData->buffers.tour,
-             drawData->vertexOrder[ProblemType::BTSPP_exact],
-             drawData->appearance.thickness[typeInt],
-             drawData->appearance.colour[typeInt]);
-    drawEdge(programs.drawLine,
-             drawData->floatVertices,
-             drawData->results.BTSPP_EXACT_RESULT.bottleneckEdge,
-             drawData->appearance.thickness[typeInt] * BOTLLENECK_EDGE_WIDTH_FACTOR,
-             drawData->appearance.colour[typeInt]);
+    drawPath(programs, *drawData->buffers.tours, ProblemType::BTSPP_exact);
+    drawEdge(programs, drawData->floatVertices, drawData->results.BTSPP_EXACT_RESULT.bottleneckEdge, ProblemType::BTSPP_exact);
   }
 
   // TSP exact
   typeInt = std::to_underlying(ProblemType::TSP_exact);
   if (ACTIVE[typeInt] && drawData->vertexOrder.initialized(ProblemType::TSP_exact)) {
-    drawPath(programs.drawPathSegments,
-             drawData->buffers.tour,
-             drawData->vertexOrder[ProblemType::TSP_exact],
-             drawData->appearance.thickness[typeInt],
-             drawData->appearance.colour[typeInt]);
+    drawPath(programs, *drawData->buffers.tours, ProblemType::TSP_exact);
   }
 }
 }  // namespace drawing
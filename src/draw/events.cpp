@@ -18,7 +18,11 @@
  */
 #include "draw/events.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <memory>
+#include <variant>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -26,77 +30,243 @@
 #include "draw/buffers.hpp"
 #include "draw/definitions.hpp"
 #include "draw/drawdata.hpp"
+#include "draw/solverworker.hpp"
 #include "draw/variables.hpp"
 
 #include "solve/approximation.hpp"
 #include "solve/exactsolver.hpp"
 
+#include "utility/utils.hpp"
+
 using namespace drawing;
 
+void requestRedraw() {
+  mainwindow::FRAMES_TO_DRAW = mainwindow::REDRAW_FRAMES;
+}
+
+/***********************************************************************************************************************
+ *                                               level of detail
+ **********************************************************************************************************************/
+
+// uploads the tour of type, simplified if the reduced level of detail is active
+static void uploadTour(std::shared_ptr<DrawData> drawData, const ProblemType type) {
+  const std::vector<size_t>& fullTour = drawData->fullTours[std::to_underlying(type)];
+  if (drawData->levelOfDetail.active()) {
+    drawData->vertexOrder.updateOrder(drawData->levelOfDetail.simplify(fullTour, drawing::EUCLIDEAN.vertices()), type);
+  }
+  else {
+    drawData->vertexOrder.updateOrder(fullTour, type);
+  }
+  drawData->buffers.tours->write(std::to_underlying(type), drawData->vertexOrder[type]);
+}
+
+// recomputes density tiles and simplified tours, only if the camera, the window size or the positions changed
+static void updateLevelOfDetail(std::shared_ptr<DrawData> drawData, const bool positionsChanged) {
+  const bool wasActive = drawData->levelOfDetail.active();
+  if (!drawData->levelOfDetail.update(
+          drawing::EUCLIDEAN.vertices(), drawing::CAMERA, mainwindow::WIDTH, mainwindow::HEIGHT, positionsChanged)) {
+    return;
+  }
+  if (drawData->levelOfDetail.active()) {
+    drawData->buffers.representatives->bufferData(drawData->levelOfDetail.representatives());
+  }
+  if (drawData->levelOfDetail.active() || wasActive) {
+    for (const ProblemType type : problemType::PROBLEM_TYPES) {
+      if (!drawData->fullTours[std::to_underlying(type)].empty()) {
+        uploadTour(drawData, type);
+      }
+    }
+  }
+}
+
 /***********************************************************************************************************************
  *                                               fast events
  **********************************************************************************************************************/
 
-static graph::Point2D transformCoordinates(const double x, const double y) {
+// maps window coordinates of the cursor to normalized device coordinates
+static graph::Point2D cursorToNdc(const double x, const double y) {
   return graph::Point2D{2.0 * x / mainwindow::WIDTH - 1.0, -2.0 * y / mainwindow::HEIGHT + 1.0};
 }
 
+// maps window coordinates of the cursor to world coordinates
+static graph::Point2D transformCoordinates(const double x, const double y) {
+  return drawing::CAMERA.toWorld(cursorToNdc(x, y));
+}
+
+// the picking radius is constant on screen
+static double pickingRadius() {
+  return drawing::VETREX_RADIUS / drawing::CAMERA.zoom;
+}
+
+static void panCamera(GLFWwindow* window) {
+  double x, y;
+  glfwGetCursorPos(window, &x, &y);
+  const graph::Point2D position = cursorToNdc(x, y);
+  drawing::CAMERA.pan(position - input::mouse::LAST_CURSOR_POSITION);
+  input::mouse::LAST_CURSOR_POSITION = position;
+}
+
 static void moveNode(GLFWwindow* window, std::shared_ptr<drawing::DrawData> drawData) {
   double x, y;
   glfwGetCursorPos(window, &x, &y);
-  drawing::EUCLIDEAN.vertices()[input::mouse::NODE_IN_MOTION] = transformCoordinates(x, y);
-  drawData->floatVertices.updatePointsfFromEuclidean(drawing::EUCLIDEAN);
-  drawData->buffers.coordinates->bufferSubData(drawData->floatVertices.read());
-  drawData->buffers.tourCoordinates->bufferSubData(drawData->floatVertices.read());
+  const graph::Point2D position = transformCoordinates(x, y);
+  drawing::VERTEX_GRID.move(input::mouse::NODE_IN_MOTION, drawing::EUCLIDEAN.vertices()[input::mouse::NODE_IN_MOTION], position);
+  drawing::EUCLIDEAN.vertices()[input::mouse::NODE_IN_MOTION] = position;
+  drawData->floatVertices.updatePoint(input::mouse::NODE_IN_MOTION, position);
+  if (drawData->floatVertices.dirty()) {  // upload only the moved vertex
+    drawData->buffers.coordinates->bufferSubData(drawData->floatVertices.read(),
+                                                 drawData->floatVertices.dirtyBegin(),
+                                                 drawData->floatVertices.dirtyCount());
+    drawData->floatVertices.clean();
+  }
+}
+
+// active approximations whose displayed result doesn't belong to the current vertex positions
+static std::array<bool, std::to_underlying(ProblemType::NUMBER_OF_OPTIONS)> LIVE_OUTDATED{};
+static Stopwatch LIVE_THROTTLE;
+
+// true if an outdated approximation waits for the throttle, outdated types with a running job are woken up by the worker
+static bool liveApproximationsWaiting(const SolverWorker& worker) {
+  return std::ranges::any_of(APPROXIMATION_TYPES, [&worker](const ProblemType type) {
+    return LIVE_OUTDATED[std::to_underlying(type)] && !worker.computing(type);
+  });
+}
+
+// submits outdated approximations, but at most one job per type at a time and not more often than the throttle allows,
+// positions that arrive while a job runs are coalesced into the next submission
+static void updateLiveApproximations(SolverWorker& worker) {
+  for (const ProblemType type : APPROXIMATION_TYPES) {
+    if (!drawing::ACTIVE[std::to_underlying(type)]) {
+      LIVE_OUTDATED[std::to_underlying(type)] = false;  // deactivated while outdated, it is never submitted
+    }
+  }
+  if (LIVE_THROTTLE.elapsedTimeInMilliseconds() < LIVE_APPROXIMATION_INTERVAL) {
+    if (liveApproximationsWaiting(worker)) {
+      requestRedraw();  // come back when the throttle has elapsed, even if no further event arrives
+    }
+    return;
+  }
+  std::shared_ptr<const graph::Euclidean> snapshot;
+  for (const ProblemType type : APPROXIMATION_TYPES) {
+    if (LIVE_OUTDATED[std::to_underlying(type)] && !worker.computing(type)) {
+      if (!snapshot) {
+        snapshot = std::make_shared<const graph::Euclidean>(drawing::EUCLIDEAN);
+      }
+      worker.submit(snapshot, type, false, true);  // no crossing constraints in approximations, don't print
+      LIVE_OUTDATED[std::to_underlying(type)] = false;
+    }
+  }
+  if (snapshot) {
+    LIVE_THROTTLE.reset();
+  }
+  if (liveApproximationsWaiting(worker)) {
+    requestRedraw();  // keep the loop running until the latest positions have been submitted
+  }
+}
+
+static int nodeAtCursor(GLFWwindow* window) {
+  double x, y;
+  glfwGetCursorPos(window, &x, &y);
+  return drawing::VERTEX_GRID.nearest(drawing::EUCLIDEAN.vertices(), transformCoordinates(x, y), pickingRadius());
 }
 
-static void handleFastEvents(GLFWwindow* window, std::shared_ptr<drawing::DrawData> drawData) {
+static void handleFastEvents(GLFWwindow* window, std::shared_ptr<drawing::DrawData> drawData, SolverWorker& worker) {
   glfwGetFramebufferSize(window, &mainwindow::WIDTH, &mainwindow::HEIGHT);  // update window size
-  if (input::STATE[GLFW_MOUSE_BUTTON_LEFT] && input::mouse::NODE_IN_MOTION != namedInts::INVALID) {
+  if (input::STATE[GLFW_MOUSE_BUTTON_RIGHT]) {
+    panCamera(window);
+  }
+  input::mouse::NODE_HOVERED = nodeAtCursor(window);
+  const bool positionsChanged = input::STATE[GLFW_MOUSE_BUTTON_LEFT] && input::mouse::NODE_IN_MOTION != namedInts::INVALID;
+  if (positionsChanged) {
+    if (drawing::LIVE_APPROXIMATION) {
+      // running approximations are kept, their results are replaced as soon as the next one finishes
+      for (const ProblemType type : problemType::PROBLEM_TYPES) {
+        if (std::find(APPROXIMATION_TYPES.begin(), APPROXIMATION_TYPES.end(), type) == APPROXIMATION_TYPES.end()) {
+          worker.cancel(type);
+        }
+      }
+      for (const ProblemType type : APPROXIMATION_TYPES) {
+        LIVE_OUTDATED[std::to_underlying(type)] = drawing::ACTIVE[std::to_underlying(type)];  // inactive types aren't submitted
+      }
+    }
+    else {
+      worker.cancelAll();  // results of running jobs belong to the old positions
+    }
     moveNode(window, drawData);
   }
+  updateLevelOfDetail(drawData, positionsChanged);
+  if (drawing::LIVE_APPROXIMATION) {
+    updateLiveApproximations(worker);
+  }
 }
 
 /***********************************************************************************************************************
  *                                               slow events
  **********************************************************************************************************************/
 
-static void handleSlowEvents(std::shared_ptr<DrawData> drawData) {
-  if (solve::SOLVE[std::to_underlying(ProblemType::BTSP_approx)]) {
-    solve::SOLVE[std::to_underlying(ProblemType::BTSP_approx)] = false;
-    drawData->results.BTSP_APPROX_RESULT                       = approximation::approximateBTSP(drawing::EUCLIDEAN);
-    drawData->vertexOrder.updateOrder(drawData->results.BTSP_APPROX_RESULT.tour, ProblemType::BTSP_approx);
-    approximation::printInfo(drawData->results.BTSP_APPROX_RESULT, ProblemType::BTSP_approx);
-  }
-  if (solve::SOLVE[std::to_underlying(ProblemType::BTSPP_approx)]) {
-    solve::SOLVE[std::to_underlying(ProblemType::BTSPP_approx)] = false;
-    drawData->results.BTSPP_APPROX_RESULT                       = approximation::approximateBTSPP(drawing::EUCLIDEAN);
-    drawData->vertexOrder.updateOrder(drawData->results.BTSPP_APPROX_RESULT.tour, ProblemType::BTSPP_approx);
-    approximation::printInfo(drawData->results.BTSPP_APPROX_RESULT, ProblemType::BTSPP_approx);
-  }
-  if (solve::SOLVE[std::to_underlying(ProblemType::BTSVPP_approx)]) {
-    solve::SOLVE[std::to_underlying(ProblemType::BTSVPP_approx)] = false;
-    drawData->results.BTSVPP_APPROX_RESULT                       = approximation::approximateBTSVPP(drawing::EUCLIDEAN);
-    drawData->vertexOrder.updateOrder(drawData->results.BTSVPP_APPROX_RESULT.tour, ProblemType::BTSVPP_approx);
-    approximation::printInfo(drawData->results.BTSVPP_APPROX_RESULT, ProblemType::BTSVPP_approx);
-  }
-  if (solve::SOLVE[std::to_underlying(ProblemType::BTSP_exact)]) {
-    solve::SOLVE[std::to_underlying(ProblemType::BTSP_exact)] = false;
-    drawData->results.BTSP_EXACT_RESULT = exactsolver::solve(drawing::EUCLIDEAN, ProblemType::BTSP_exact, solve::BTSP_FORBID_CROSSING);
-    drawData->vertexOrder.updateOrder(drawData->results.BTSP_EXACT_RESULT.tour, ProblemType::BTSP_exact);
-    exactsolver::printInfo(drawData->results.BTSP_EXACT_RESULT, ProblemType::BTSP_exact);
-  }
-  if (solve::SOLVE[std::to_underlying(ProblemType::BTSPP_exact)]) {
-    solve::SOLVE[std::to_underlying(ProblemType::BTSPP_exact)] = false;
-    drawData->results.BTSPP_EXACT_RESULT = exactsolver::solve(drawing::EUCLIDEAN, ProblemType::BTSPP_exact, solve::BTSP_FORBID_CROSSING);
-    drawData->vertexOrder.updateOrder(drawData->results.BTSPP_EXACT_RESULT.tour, ProblemType::BTSPP_exact);
-    exactsolver::printInfo(drawData->results.BTSPP_EXACT_RESULT, ProblemType::BTSPP_exact);
-  }
-  if (solve::SOLVE[std::to_underlying(ProblemType::TSP_exact)]) {
-    solve::SOLVE[std::to_underlying(ProblemType::TSP_exact)] = false;
-    exactsolver::Result res                                  = exactsolver::solve(drawing::EUCLIDEAN, ProblemType::TSP_exact);
-    drawData->vertexOrder.updateOrder(res.tour, ProblemType::TSP_exact);
-    exactsolver::printInfo(res, ProblemType::TSP_exact);
+// the tour is uploaded only here and in updateLevelOfDetail(), drawing reuses the uploaded region in every frame
+static void updateTour(std::shared_ptr<DrawData> drawData, const std::vector<size_t>& tour, const ProblemType type) {
+  drawData->fullTours[std::to_underlying(type)] = tour;
+  uploadTour(drawData, type);
+}
+
+static void applyApproximation(std::shared_ptr<DrawData> drawData, const approximation::Result& result, const ProblemType type) {
+  updateTour(drawData, result.tour, type);
+  switch (type) {
+  case ProblemType::BTSP_approx:
+    drawData->results.BTSP_APPROX_RESULT = result;
+    drawData->edgeLists.BTSP_BICONNECTED_GRAPH.update(result.biconnectedGraph);
+    drawData->edgeLists.BTSP_OPEN_EAR_DECOMPOSITION.update(result.openEarDecomposition);
+    break;
+  case ProblemType::BTSPP_approx:
+    drawData->results.BTSPP_APPROX_RESULT = result;
+    drawData->edgeLists.BTSPP_BICONNECTED_GRAPH.update(result.biconnectedGraph);
+    break;
+  case ProblemType::BTSVPP_approx:
+    drawData->results.BTSVPP_APPROX_RESULT = result;
+    drawData->edgeLists.BTSVPP_BICONNECTED_GRAPH.update(result.biconnectedGraph);
+    break;
+  default:
+    break;
+  }
+}
+
+static void applyExact(std::shared_ptr<DrawData> drawData, const exactsolver::Result& result, const ProblemType type) {
+  updateTour(drawData, result.tour, type);
+  if (type == ProblemType::BTSP_exact) {
+    drawData->results.BTSP_EXACT_RESULT = result;
+  }
+  else if (type == ProblemType::BTSPP_exact) {
+    drawData->results.BTSPP_EXACT_RESULT = result;
+  }
+}
+
+// dispatches requested solves to the worker and takes over finished results, the GL buffers are updated here because
+// only the render thread owns the OpenGL context
+static void handleSlowEvents(std::shared_ptr<DrawData> drawData, SolverWorker& worker) {
+  std::shared_ptr<const graph::Euclidean> snapshot;
+  for (const ProblemType type : problemType::PROBLEM_TYPES) {
+    if (solve::SOLVE[std::to_underlying(type)]) {
+      solve::SOLVE[std::to_underlying(type)] = false;
+      if (!snapshot) {
+        snapshot = std::make_shared<const graph::Euclidean>(drawing::EUCLIDEAN);
+      }
+      worker.submit(snapshot, type, solve::BTSP_FORBID_CROSSING);
+    }
+  }
+
+  for (const ProblemType type : problemType::PROBLEM_TYPES) {
+    const std::shared_ptr<const SolverOutput> output = worker.collect(type);
+    if (!output || output->failed()) {
+      continue;  // the worker has reported the error, the previous result stays on screen
+    }
+    if (const approximation::Result* result = std::get_if<approximation::Result>(&output->result)) {
+      applyApproximation(drawData, *result, type);
+    }
+    else {
+      applyExact(drawData, std::get<exactsolver::Result>(output->result), type);
+    }
+    requestRedraw();
   }
 }
 
@@ -104,9 +274,9 @@ static void handleSlowEvents(std::shared_ptr<DrawData> drawData) {
  *                                           event handling
  **********************************************************************************************************************/
 
-void handleEvents(GLFWwindow* window, std::shared_ptr<drawing::DrawData> drawData) {
-  handleFastEvents(window, drawData);
-  handleSlowEvents(drawData);
+void handleEvents(GLFWwindow* window, std::shared_ptr<drawing::DrawData> drawData, SolverWorker& worker) {
+  handleFastEvents(window, drawData, worker);
+  handleSlowEvents(drawData, worker);
 }
 
 /***********************************************************************************************************************
@@ -121,12 +291,8 @@ static void selectNodeToMove(GLFWwindow* window) {
   double x, y;
   glfwGetCursorPos(window, &x, &y);
   input::mouse::MOUSE_LEFT_CLICKED = transformCoordinates(x, y);
-  for (unsigned int i = 0; i < drawing::EUCLIDEAN.vertices().size(); ++i) {
-    if (norm2(drawing::EUCLIDEAN.vertices()[i] - input::mouse::MOUSE_LEFT_CLICKED) < drawing::VETREX_RADIUS) {
-      input::mouse::NODE_IN_MOTION = i;
-      break;  // move only one point at one at a time
-    }
-  }
+  input::mouse::NODE_IN_MOTION =
+      drawing::VERTEX_GRID.nearest(drawing::EUCLIDEAN.vertices(), input::mouse::MOUSE_LEFT_CLICKED, pickingRadius());
 }
 
 static void cycleBTSPApproxDisplay() {
@@ -180,6 +346,7 @@ static void cycleBTSVPPApproxDisplay() {
  **********************************************************************************************************************/
 
 void keyCallback([[maybe_unused]] GLFWwindow* window, int key, [[maybe_unused]] int scancode, int action, [[maybe_unused]] int mods) {
+  requestRedraw();
   if (key == GLFW_KEY_F1 && action == GLFW_PRESS) {
     toggle(drawing::SHOW_DEBUG_WINDOW);
   }
@@ -214,6 +381,9 @@ void keyCallback([[maybe_unused]] GLFWwindow* window, int key, [[maybe_unused]]
   if (key == GLFW_KEY_6 && action == GLFW_PRESS) {
     toggle(drawing::ACTIVE[std::to_underlying(ProblemType::TSP_exact)]);
   }
+  if (key == GLFW_KEY_L && action == GLFW_PRESS) {
+    toggle(drawing::LIVE_APPROXIMATION);
+  }
   if (key == GLFW_KEY_C && action == GLFW_PRESS) {
     toggle(drawing::COLLAPSE_SETTINGS_WINDOW);
   }
@@ -231,6 +401,7 @@ void keyCallback([[maybe_unused]] GLFWwindow* window, int key, [[maybe_unused]]
 }
 
 void mouseButtonCallback([[maybe_unused]] GLFWwindow* window, int button, int action, [[maybe_unused]] int mods) {
+  requestRedraw();
   if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
     input::STATE[GLFW_MOUSE_BUTTON_LEFT] = true;
     selectNodeToMove(window);
@@ -239,4 +410,28 @@ void mouseButtonCallback([[maybe_unused]] GLFWwindow* window, int button, int ac
     input::STATE[GLFW_MOUSE_BUTTON_LEFT] = false;
     input::mouse::NODE_IN_MOTION         = namedInts::INVALID;
   }
-}
\ No newline at end of file
+  if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS) {
+    double x, y;
+    glfwGetCursorPos(window, &x, &y);
+    input::STATE[GLFW_MOUSE_BUTTON_RIGHT] = true;
+    input::mouse::LAST_CURSOR_POSITION    = cursorToNdc(x, y);
+  }
+  if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_RELEASE) {
+    input::STATE[GLFW_MOUSE_BUTTON_RIGHT] = false;
+  }
+}
+
+void scrollCallback(GLFWwindow* window, [[maybe_unused]] double xoffset, double yoffset) {
+  requestRedraw();
+  double x, y;
+  glfwGetCursorPos(window, &x, &y);
+  drawing::CAMERA.zoomAt(cursorToNdc(x, y), std::pow(ZOOM_STEP, yoffset));
+}
+
+void cursorPositionCallback([[maybe_unused]] GLFWwindow* window, [[maybe_unused]] double x, [[maybe_unused]] double y) {
+  requestRedraw();
+}
+
+void framebufferSizeCallback([[maybe_unused]] GLFWwindow* window, [[maybe_unused]] int width, [[maybe_unused]] int height) {
+  requestRedraw();
+}
@@ -28,6 +28,7 @@
 
 #include "draw/definitions.hpp"
 #include "draw/drawdata.hpp"
+#include "draw/solverworker.hpp"
 #include "draw/variables.hpp"
 
 using namespace drawing;
@@ -58,7 +59,14 @@ void setUpImgui(GLFWwindow* window, const char* glsl_version) {
   ImGui_ImplOpenGL3_Init(glsl_version);
 }
 
-void drawImgui(Appearance& appearance) {
+static void showComputingState(const SolverWorker& worker, const ProblemType type) {
+  if (worker.computing(type)) {
+    ImGui::SameLine();
+    ImGui::Text("computing...");
+  }
+}
+
+void drawImgui(Appearance& appearance, const SolverWorker& worker) {
   ImGui_ImplOpenGL3_NewFrame();
   ImGui_ImplGlfw_NewFrame();
   ImGui::NewFrame();
@@ -66,6 +74,7 @@ void drawImgui(Appearance& appearance) {
   if (drawing::SHOW_DEBUG_WINDOW) {
     ImGui::Begin("Debug", &drawing::SHOW_DEBUG_WINDOW);
     ImGui::Text("Node in motion: %d", input::mouse::NODE_IN_MOTION);
+    ImGui::Text("Node hovered: %d", input::mouse::NODE_HOVERED);
     ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
     ImGui::End();
   }
@@ -76,6 +85,7 @@ void drawImgui(Appearance& appearance) {
     ImGui::SetWindowCollapsed(drawing::COLLAPSE_SETTINGS_WINDOW);
 
     ImGui::Checkbox("BTSP approx", &drawing::ACTIVE[std::to_underlying(ProblemType::BTSP_approx)]);
+    showComputingState(worker, ProblemType::BTSP_approx);
     ImGui::ColorEdit3("##BTSP approx", (float*) &appearance.colour[std::to_underlying(ProblemType::BTSP_approx)]);
     ImGui::SliderFloat("thickness##BTSP approx", &appearance.thickness[std::to_underlying(ProblemType::BTSP_approx)], 0.0f, 30.0f, "%.1f");
 
@@ -86,6 +96,7 @@ void drawImgui(Appearance& appearance) {
     ImGui::Separator();
 
     ImGui::Checkbox("BTSPP approx", &drawing::ACTIVE[std::to_underlying(ProblemType::BTSPP_approx)]);
+    showComputingState(worker, ProblemType::BTSPP_approx);
     ImGui::ColorEdit3("##BTSPP approx", (float*) &appearance.colour[std::to_underlying(ProblemType::BTSPP_approx)]);
     ImGui::SliderFloat("thickness##BTSPP approx",
                        &appearance.thickness[std::to_underlying(ProblemType::BTSPP_approx)],
@@ -99,6 +110,7 @@ void drawImgui(Appearance& appearance) {
     ImGui::Separator();
 
     ImGui::Checkbox("BTSVPP approx", &drawing::ACTIVE[std::to_underlying(ProblemType::BTSVPP_approx)]);
+    showComputingState(worker, ProblemType::BTSVPP_approx);
     ImGui::ColorEdit3("##BTSVPP approx", (float*) &appearance.colour[std::to_underlying(ProblemType::BTSVPP_approx)]);
     ImGui::SliderFloat("thickness##BTSVPP approx",
                        &appearance.thickness[std::to_underlying(ProblemType::BTSVPP_approx)],
@@ -112,6 +124,7 @@ void drawImgui(Appearance& appearance) {
     ImGui::Separator();
 
     ImGui::Checkbox("BTSP exact", &drawing::ACTIVE[std::to_underlying(ProblemType::BTSP_exact)]);
+    showComputingState(worker, ProblemType::BTSP_exact);
     ImGui::SliderFloat("thickness##BTSP exact", &appearance.thickness[std::to_underlying(ProblemType::BTSP_exact)], 0.0f, 20.0f, "%.1f");
     ImGui::ColorEdit3("##BTSP exact", (float*) &appearance.colour[std::to_underlying(ProblemType::BTSP_exact)]);
 
@@ -119,15 +132,20 @@ void drawImgui(Appearance& appearance) {
     ImGui::Separator();
 
     ImGui::Checkbox("BTSPP exact", &drawing::ACTIVE[std::to_underlying(ProblemType::BTSPP_exact)]);
+    showComputingState(worker, ProblemType::BTSPP_exact);
     ImGui::SliderFloat("thickness##BTSPP exact", &appearance.thickness[std::to_underlying(ProblemType::BTSPP_exact)], 0.0f, 20.0f, "%.1f");
     ImGui::ColorEdit3("##BTSPP exact", (float*) &appearance.colour[std::to_underlying(ProblemType::BTSPP_exact)]);
     ImGui::Separator();
 
     ImGui::Checkbox("TSP  exact", &drawing::ACTIVE[std::to_underlying(ProblemType::TSP_exact)]);
+    showComputingState(worker, ProblemType::TSP_exact);
     ImGui::ColorEdit3("##TSP exact", (float*) &appearance.colour[std::to_underlying(ProblemType::TSP_exact)]);
     ImGui::SliderFloat("thickness##TSP exact", &appearance.thickness[std::to_underlying(ProblemType::TSP_exact)], 0.0f, 30.0f, "%.1f");
     ImGui::Separator();
 
+    ImGui::Checkbox("live approximation while dragging", &drawing::LIVE_APPROXIMATION);
+    ImGui::Separator();
+
     ImGui::ColorEdit4("clear colour", (float*) &appearance.clearColour);
     ImGui::ColorEdit3("vertex colour", (float*) &appearance.vertexColour);
     ImGui::End();
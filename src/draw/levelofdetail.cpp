@@ -0,0 +1,91 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "draw/levelofdetail.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// graph library
+#include "geometry.hpp"
+
+#include "draw/camera.hpp"
+
+namespace drawing {
+static constexpr size_t MIN_TOUR_SIZE = 4;  // the path shader needs at least one segment plus neighbours
+
+bool LevelOfDetail::update(const std::vector<graph::Point2D>& points,
+                           const Camera& camera,
+                           const int width,
+                           const int height,
+                           const bool positionsChanged) {
+  if (pValid && !positionsChanged && camera == pCamera && width == pWidth && height == pHeight) {
+    return false;
+  }
+  pCamera = camera;
+  pWidth  = width;
+  pHeight = height;
+  pValid  = true;
+
+  const size_t tilesPerRow    = static_cast<size_t>(std::max(1, width / LOD_TILE_PIXELS + 1));
+  const size_t tilesPerColumn = static_cast<size_t>(std::max(1, height / LOD_TILE_PIXELS + 1));
+  std::vector<bool> occupied(tilesPerRow * tilesPerColumn, false);
+  pRepresentatives.clear();
+  size_t visible = 0;
+  for (size_t u = 0; u < points.size(); ++u) {
+    const graph::Point2D ndc = camera.toNdc(points[u]);
+    if (ndc.x < -1.0 || ndc.x > 1.0 || ndc.y < -1.0 || ndc.y > 1.0) {
+      continue;
+    }
+    ++visible;
+    const size_t column = static_cast<size_t>((ndc.x + 1.0) * 0.5 * width) / LOD_TILE_PIXELS;
+    const size_t row    = static_cast<size_t>((ndc.y + 1.0) * 0.5 * height) / LOD_TILE_PIXELS;
+    const size_t tile   = std::min(row, tilesPerColumn - 1) * tilesPerRow + std::min(column, tilesPerRow - 1);
+    if (!occupied[tile]) {
+      occupied[tile] = true;
+      pRepresentatives.push_back(static_cast<uint32_t>(u));
+    }
+  }
+  pActive = (visible > LOD_VERTEX_THRESHOLD);
+  return true;
+}
+
+std::vector<size_t> LevelOfDetail::simplify(const std::vector<size_t>& tour, const std::vector<graph::Point2D>& points) const {
+  if (tour.size() <= MIN_TOUR_SIZE) {
+    return tour;
+  }
+  // pixels per world unit in x and y direction
+  const double scaleX = 0.5 * pWidth * pCamera.zoom;
+  const double scaleY = 0.5 * pHeight * pCamera.zoom;
+
+  std::vector<size_t> simplified;
+  simplified.reserve(tour.size());
+  simplified.push_back(tour.front());
+  for (size_t i = 1; i + 1 < tour.size(); ++i) {
+    const graph::Point2D difference = points[tour[i]] - points[simplified.back()];
+    if (std::hypot(difference.x * scaleX, difference.y * scaleY) >= LOD_PIXEL_TOLERANCE) {
+      simplified.push_back(tour[i]);
+    }
+  }
+  simplified.push_back(tour.back());
+  return (simplified.size() < MIN_TOUR_SIZE ? tour : simplified);
+}
+}  // namespace drawing
@@ -27,17 +27,37 @@
 
 #include "draw/openglerrors.hpp"
 
-static constexpr const char vertexShaderSource[] = R"glsl(
+// precedes the shaders that read the appearance and view uniform block, contains the version directive
+static constexpr const char viewHeaderSource[] = R"glsl(
   #version 440 core
+  struct TypeAppearance {
+    vec4 colour;
+    float thickness;
+  };
+
+  layout(std140, binding = 0) uniform appearanceBlock
+  {
+    TypeAppearance u_appearance[6];  // one per ProblemType
+    vec2 u_resolution;
+    vec2 u_cameraCenter;
+    float u_zoom;
+  };
+
+  // maps world coordinates to normalized device coordinates
+  vec2 project(vec2 point) {
+    return (point - u_cameraCenter) * u_zoom;
+  }
+)glsl";
+
+static constexpr const char vertexShaderSource[] = R"glsl(
   in vec2 vertexPosition;
 
   void main() {
-    gl_Position = vec4(vertexPosition, 0.0, 1.0);
+    gl_Position = vec4(project(vertexPosition), 0.0, 1.0);
   }
 )glsl";
 
 static constexpr const char pathVertexShaderSource[] = R"glsl(
-  #version 440 core
   layout(std430, binding = 0) buffer lineVertex
   {
      vec2 vertex[];
@@ -48,10 +68,12 @@ static constexpr const char pathVertexShaderSource[] = R"glsl(
     uint index[];
   };
 
-  uniform float u_thickness;
-  uniform vec2 u_resolution;
+  uniform int u_type;
+
+  out vec4 colour;
 
   void main() {
+    float thickness      = u_appearance[u_type].thickness;
     int line_segment     = gl_VertexID / 6;
     int triangle_vertex  = gl_VertexID % 6;
 
@@ -64,9 +86,9 @@ static constexpr const char pathVertexShaderSource[] = R"glsl(
       vec2 prev_perpendicular = vec2(-prev_direction.y, prev_direction.x);
 
       vec2 corner_direction = prev_perpendicular + line_perpendicular;
-      vec2 offset = u_thickness / dot(corner_direction, line_perpendicular) * corner_direction / u_resolution;
+      vec2 offset = thickness / dot(corner_direction, line_perpendicular) * corner_direction / u_resolution;
 
-      pos = vertex[index[line_segment + 1]];
+      pos = project(vertex[index[line_segment + 1]]);
       if(triangle_vertex == 0) {
         pos -= offset;
       }
@@ -79,9 +101,9 @@ static constexpr const char pathVertexShaderSource[] = R"glsl(
       vec2 succ_perpendicular = vec2(-succ_direction.y, succ_direction.x);
 
       vec2 corner_direction = succ_perpendicular + line_perpendicular;
-      vec2 offset = u_thickness / dot(corner_direction, line_perpendicular) * corner_direction / u_resolution;
+      vec2 offset = thickness / dot(corner_direction, line_perpendicular) * corner_direction / u_resolution;
 
-      pos = vertex[index[line_segment + 2]];
+      pos = project(vertex[index[line_segment + 2]]);
       if(triangle_vertex == 4) {
         pos += offset;
       }
@@ -90,23 +112,77 @@ static constexpr const char pathVertexShaderSource[] = R"glsl(
       }
     }
     gl_Position = vec4(pos, 0.0, 1.0);
+    colour = u_appearance[u_type].colour;
   }
 )glsl";
 
 static constexpr const char lineVertexShaderSource[] = R"glsl(
-  #version 440 core
-
   uniform vec4 u_ends;
-  uniform float u_thickness;
-  uniform vec2 u_resolution;
+  uniform int u_type;
+  uniform float u_thicknessFactor;
+
+  out vec4 colour;
+
+  void main() {
+    int triangle_vertex  = gl_VertexID % 6;
+    vec2 begin = project(u_ends.xy);
+    vec2 end   = project(u_ends.zw);
+    vec2 direction = normalize(end - begin);
+    vec2 perpendicular = vec2(-direction.y, direction.x);
+    vec2 offset = u_thicknessFactor * u_appearance[u_type].thickness * perpendicular / u_resolution;
+
+    vec2 pos;
+    if(triangle_vertex == 0 || triangle_vertex == 2 || triangle_vertex == 5) {
+      pos = begin;
+      if(triangle_vertex == 0) {
+        pos -= offset;
+      }
+      else {
+        pos += offset;
+      }
+    }
+    else {
+      pos = end;
+      if(triangle_vertex == 4) {
+        pos += offset;
+      }
+      else {
+        pos -= offset;
+      }
+    }
+    gl_Position = vec4(pos, 0.0, 1.0);
+    colour = u_appearance[u_type].colour;
+  }
+)glsl";
+
+static constexpr const char edgeVertexShaderSource[] = R"glsl(
+  layout(std430, binding = 0) buffer lineVertex
+  {
+     vec2 vertex[];
+  };
+
+  struct Edge {
+    uint u;
+    uint v;
+    float fade;
+  };
+
+  layout(std430, binding = 2) buffer edgeList
+  {
+    Edge edge[];
+  };
+
+  uniform int u_type;
+
+  out vec4 colour;
 
   void main() {
     int triangle_vertex  = gl_VertexID % 6;
-    vec2 begin = u_ends.xy;
-    vec2 end   = u_ends.zw;
+    vec2 begin = project(vertex[edge[gl_InstanceID].u]);
+    vec2 end   = project(vertex[edge[gl_InstanceID].v]);
     vec2 direction = normalize(end - begin);
     vec2 perpendicular = vec2(-direction.y, direction.x);
-    vec2 offset = u_thickness * perpendicular / u_resolution;
+    vec2 offset = u_appearance[u_type].thickness * perpendicular / u_resolution;
 
     vec2 pos;
     if(triangle_vertex == 0 || triangle_vertex == 2 || triangle_vertex == 5) {
@@ -128,6 +204,8 @@ static constexpr const char lineVertexShaderSource[] = R"glsl(
       }
     }
     gl_Position = vec4(pos, 0.0, 1.0);
+    vec4 typeColour = u_appearance[u_type].colour;
+    colour = vec4(edge[gl_InstanceID].fade * typeColour.rgb, typeColour.a);
   }
 )glsl";
 
@@ -164,7 +242,18 @@ static constexpr const char fragmentShaderSource[] = R"glsl(
   }
 )glsl";
 
-void ShaderProgram::link() const {
+static constexpr const char colouredFragmentShaderSource[] = R"glsl(
+  #version 440 core
+  layout (location = 0) out vec4 fragColor;
+
+  in vec4 colour;
+
+  void main() {
+    fragColor = colour;
+  }
+)glsl";
+
+void ShaderProgram::link() {
   GL_CALL(glLinkProgram(pProgramID);)
 
   int success;
@@ -174,42 +263,36 @@ void ShaderProgram::link() const {
   if (!success) {
     GL_CALL(glGetProgramInfoLog(pProgramID, 512, nullptr, infoLog);)
     std::cerr << "ERROR Linking of shaders failed\n" << infoLog << std::endl;
+    return;
   }
-}
 
-void ShaderProgram::setUniform(const char* name, const float value) const {
-  GL_CALL(const GLint location = glGetUniformLocation(pProgramID, name);)
-  assert(location != -1 && "could not find uniform");
-  GL_CALL(glUniform1f(location, value);)
-}
-
-void ShaderProgram::setUniform(const char* name, const int value) const {
-  GL_CALL(const GLint location = glGetUniformLocation(pProgramID, name);)
-  assert(location != -1 && "could not find uniform");
-  GL_CALL(glUniform1i(location, value);)
-}
-
-void ShaderProgram::setUniform(const char* name, const float val1, const float val2) const {
-  GL_CALL(const GLint location = glGetUniformLocation(pProgramID, name);)
-  assert(location != -1 && "could not find uniform");
-  GL_CALL(glUniform2f(location, val1, val2);)
-}
-
-void ShaderProgram::setUniform(const char* name, const float val1, const float val2, const float val3, const float val4) const {
-  GL_CALL(const GLint location = glGetUniformLocation(pProgramID, name);)
-  assert(location != -1 && "could not find uniform");
-  GL_CALL(glUniform4f(location, val1, val2, val3, val4);)
-}
-
-void ShaderProgram::setUniform(const char* name, const std::array<float, 4>& value) const {
-  GL_CALL(const GLint location = glGetUniformLocation(pProgramID, name);)
-  assert(location != -1 && "could not find uniform");
-  GL_CALL(glUniform4f(location, value[0], value[1], value[2], value[3]);)
+  GLint numberOfUniforms;
+  GLint maxNameLength;
+  GL_CALL(glGetProgramiv(pProgramID, GL_ACTIVE_UNIFORMS, &numberOfUniforms);)
+  GL_CALL(glGetProgramiv(pProgramID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);)
+  std::string name(maxNameLength, '\0');
+  pUniforms.clear();
+  for (GLint i = 0; i < numberOfUniforms; ++i) {
+    GLsizei length;
+    GLint size;
+    GLenum type;
+    GL_CALL(glGetActiveUniform(pProgramID, i, maxNameLength, &length, &size, &type, name.data());)
+    GL_CALL(const GLint location = glGetUniformLocation(pProgramID, name.c_str());)
+    if (location != -1) {  // members of uniform blocks have no location
+      pUniforms.emplace(name.substr(0, length), UniformInfo{location, type});
+    }
+  }
 }
 
-static GLuint compileShader(const GLenum shaderType, const GLchar* shaderSource) {
+static GLuint compileShader(const GLenum shaderType, const GLchar* shaderSource, const GLchar* headerSource = nullptr) {
   GL_CALL(const GLuint shader = glCreateShader(shaderType);)
-  GL_CALL(glShaderSource(shader, 1, &shaderSource, nullptr);)
+  if (headerSource != nullptr) {
+    const GLchar* sources[] = {headerSource, shaderSource};
+    GL_CALL(glShaderSource(shader, 2, sources, nullptr);)
+  }
+  else {
+    GL_CALL(glShaderSource(shader, 1, &shaderSource, nullptr);)
+  }
   GL_CALL(glCompileShader(shader);)
   int success;
   char infoLog[512];
@@ -223,11 +306,13 @@ static GLuint compileShader(const GLenum shaderType, const GLchar* shaderSource)
 }
 
 ShaderCollection::ShaderCollection() :
-  pVertexShader(compileShader(GL_VERTEX_SHADER, vertexShaderSource)),
+  pVertexShader(compileShader(GL_VERTEX_SHADER, vertexShaderSource, viewHeaderSource)),
   pCircleShader(compileShader(GL_GEOMETRY_SHADER, circleShaderSource)),
-  pPathVertexShader(compileShader(GL_VERTEX_SHADER, pathVertexShaderSource)),
+  pPathVertexShader(compileShader(GL_VERTEX_SHADER, pathVertexShaderSource, viewHeaderSource)),
   pFragmentShader(compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource)),
-  pLineVertexShader(compileShader(GL_VERTEX_SHADER, lineVertexShaderSource)) {}
+  pLineVertexShader(compileShader(GL_VERTEX_SHADER, lineVertexShaderSource, viewHeaderSource)),
+  pEdgeVertexShader(compileShader(GL_VERTEX_SHADER, edgeVertexShaderSource, viewHeaderSource)),
+  pColouredFragmentShader(compileShader(GL_FRAGMENT_SHADER, colouredFragmentShaderSource)) {}
 
 ShaderCollection::~ShaderCollection() {
   GL_CALL(glDeleteShader(pVertexShader);)
@@ -235,10 +320,12 @@ ShaderCollection::~ShaderCollection() {
   GL_CALL(glDeleteShader(pPathVertexShader);)
   GL_CALL(glDeleteShader(pFragmentShader);)
   GL_CALL(glDeleteShader(pLineVertexShader);)
+  GL_CALL(glDeleteShader(pEdgeVertexShader);)
+  GL_CALL(glDeleteShader(pColouredFragmentShader);)
 }
 
 ShaderProgram ShaderCollection::linkCircleDrawProgram() const {
-  const ShaderProgram circleProgram;
+  ShaderProgram circleProgram;
   circleProgram.attachShader(pVertexShader);
   circleProgram.attachShader(pCircleShader);
   circleProgram.attachShader(pFragmentShader);
@@ -247,17 +334,25 @@ ShaderProgram ShaderCollection::linkCircleDrawProgram() const {
 }
 
 ShaderProgram ShaderCollection::linkPathSegementDrawProgram() const {
-  const ShaderProgram pathSegmentProgram;
+  ShaderProgram pathSegmentProgram;
   pathSegmentProgram.attachShader(pPathVertexShader);
-  pathSegmentProgram.attachShader(pFragmentShader);
+  pathSegmentProgram.attachShader(pColouredFragmentShader);
   pathSegmentProgram.link();
   return pathSegmentProgram;
 }
 
 ShaderProgram ShaderCollection::linkLineDrawProgram() const {
-  const ShaderProgram lineProgram;
+  ShaderProgram lineProgram;
   lineProgram.attachShader(pLineVertexShader);
-  lineProgram.attachShader(pFragmentShader);
+  lineProgram.attachShader(pColouredFragmentShader);
   lineProgram.link();
   return lineProgram;
 }
+
+ShaderProgram ShaderCollection::linkEdgeDrawProgram() const {
+  ShaderProgram edgeProgram;
+  edgeProgram.attachShader(pEdgeVertexShader);
+  edgeProgram.attachShader(pColouredFragmentShader);
+  edgeProgram.link();
+  return edgeProgram;
+}
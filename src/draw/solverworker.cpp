@@ -0,0 +1,178 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "draw/solverworker.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <variant>
+
+#include <GLFW/glfw3.h>
+
+// graph library
+#include "graph.hpp"
+
+#include "exception/exceptions.hpp"
+
+#include "draw/definitions.hpp"
+
+#include "solve/approximation.hpp"
+#include "solve/definitions.hpp"
+#include "solve/exactsolver.hpp"
+
+#include "utility/perfcounter.hpp"
+#include "utility/utils.hpp"
+
+namespace drawing {
+static std::mutex PRINT_MUTEX;  // keeps the terminal output of parallel jobs apart
+
+unsigned int SolverWorker::defaultNumberOfThreads() {
+  return std::clamp(std::thread::hardware_concurrency(), 1u, static_cast<unsigned int>(NUMBER_OF_TYPES));
+}
+
+SolverWorker::SolverWorker(const unsigned int numberOfThreads) {
+  pThreads.reserve(numberOfThreads);
+  for (unsigned int i = 0; i < numberOfThreads; ++i) {
+    pThreads.emplace_back(&SolverWorker::run, this);
+  }
+}
+
+SolverWorker::~SolverWorker() {
+  cancelAll();
+  {
+    std::lock_guard<std::mutex> lock(pQueueMutex);
+    pStop = true;
+  }
+  pQueueCondition.notify_all();
+  for (std::thread& thread : pThreads) {
+    thread.join();
+  }
+}
+
+void SolverWorker::submit(const std::shared_ptr<const graph::Euclidean> euclidean,
+                          const ProblemType type,
+                          const bool noCrossing,
+                          const bool silent) {
+  const uint64_t generation = ++pGeneration[std::to_underlying(type)];
+  pPending[std::to_underlying(type)].store(generation);
+  {
+    std::lock_guard<std::mutex> lock(pQueueMutex);
+    pQueue.push_back(Job{euclidean, type, generation, noCrossing, silent});
+  }
+  pQueueCondition.notify_one();
+}
+
+void SolverWorker::cancel(const ProblemType type) {
+  ++pGeneration[std::to_underlying(type)];
+  pPending[std::to_underlying(type)].store(0);
+  pFinished[std::to_underlying(type)].store(nullptr);
+}
+
+void SolverWorker::cancelAll() {
+  for (const ProblemType type : problemType::PROBLEM_TYPES) {
+    cancel(type);
+  }
+}
+
+std::shared_ptr<const SolverOutput> SolverWorker::collect(const ProblemType type) {
+  std::shared_ptr<const SolverOutput> output = pFinished[std::to_underlying(type)].exchange(nullptr);
+  if (output && output->generation != pGeneration[std::to_underlying(type)].load()) {
+    return nullptr;  // cancelled between finishing and publishing
+  }
+  return output;
+}
+
+void SolverWorker::run() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(pQueueMutex);
+      pQueueCondition.wait(lock, [this] { return pStop || !pQueue.empty(); });
+      if (pStop) {
+        return;
+      }
+      job = std::move(pQueue.front());
+      pQueue.pop_front();
+    }
+    if (current(job)) {
+      execute(job);
+    }
+  }
+}
+
+void SolverWorker::execute(const Job& job) {
+  perfcounter::reset();
+  std::shared_ptr<SolverOutput> output = std::make_shared<SolverOutput>();
+  output->type                         = job.type;
+  output->generation                   = job.generation;
+  const std::function<bool()> superseded = [this, &job] { return !current(job); };
+  try {
+    switch (job.type) {
+    case ProblemType::BTSP_approx:
+      output->result = approximation::approximateBTSP(*job.euclidean);
+      break;
+    case ProblemType::BTSPP_approx:
+      output->result = approximation::approximateBTSPP(*job.euclidean);
+      break;
+    case ProblemType::BTSVPP_approx:
+      output->result = approximation::approximateBTSVPP(*job.euclidean);
+      break;
+    case ProblemType::BTSP_exact:
+    case ProblemType::BTSPP_exact:
+      output->result = exactsolver::solve(*job.euclidean, job.type, job.noCrossing, superseded);
+      break;
+    case ProblemType::TSP_exact:
+      output->result = exactsolver::solve(*job.euclidean, job.type, false, superseded);
+      break;
+    default:
+      throw UnknownType("[SOLVER WORKER] Unknown problem type.");
+    }
+  }
+  catch (const std::exception& e) {
+    output->error = e.what();  // an interrupted solve has been superseded and is dropped below
+  }
+
+  // every exit path releases the pending generation, unless a newer job or cancel() has taken it over
+  uint64_t generation = job.generation;
+  if (!pPending[std::to_underlying(job.type)].compare_exchange_strong(generation, 0)) {
+    return;  // superseded while running
+  }
+  if (output->failed()) {
+    std::lock_guard<std::mutex> lock(PRINT_MUTEX);
+    printLightred("Error");
+    std::cerr << ": Failed to solve " << job.type << ", " << output->error << std::endl;
+  }
+  else if (!job.silent) {
+    std::lock_guard<std::mutex> lock(PRINT_MUTEX);
+    if (const approximation::Result* res = std::get_if<approximation::Result>(&output->result)) {
+      approximation::printInfo(*res, job.type);
+    }
+    else {
+      exactsolver::printInfo(std::get<exactsolver::Result>(output->result), job.type);
+    }
+  }
+  pFinished[std::to_underlying(job.type)].store(std::move(output));
+  glfwPostEmptyEvent();  // wakes up the render loop if it waits for events
+}
+}  // namespace drawing
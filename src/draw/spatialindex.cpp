@@ -0,0 +1,94 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "draw/spatialindex.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+// graph library
+#include "geometry.hpp"
+
+#include "draw/definitions.hpp"
+
+namespace drawing {
+static constexpr double GRID_MIN = -1.0;
+static constexpr double GRID_MAX = 1.0;
+
+UniformGrid::UniformGrid(const std::vector<graph::Point2D>& points, const double cellSize) :
+  pCellSize(cellSize),
+  pCellsPerSide(std::max<size_t>(1, static_cast<size_t>(std::ceil((GRID_MAX - GRID_MIN) / cellSize)))),
+  pCells(pCellsPerSide * pCellsPerSide) {
+  for (size_t u = 0; u < points.size(); ++u) {
+    pCells[cell(points[u])].push_back(u);
+  }
+}
+
+size_t UniformGrid::column(const double x) const {
+  const double index = std::floor((x - GRID_MIN) / pCellSize);
+  return static_cast<size_t>(std::clamp(index, 0.0, static_cast<double>(pCellsPerSide - 1)));
+}
+
+size_t UniformGrid::row(const double y) const {
+  const double index = std::floor((y - GRID_MIN) / pCellSize);
+  return static_cast<size_t>(std::clamp(index, 0.0, static_cast<double>(pCellsPerSide - 1)));
+}
+
+void UniformGrid::move(const size_t u, const graph::Point2D& from, const graph::Point2D& to) {
+  const size_t oldCell = cell(from);
+  const size_t newCell = cell(to);
+  if (oldCell == newCell) {
+    return;
+  }
+  std::vector<size_t>& bucket = pCells[oldCell];
+  const auto it               = std::find(bucket.begin(), bucket.end(), u);
+  assert(it != bucket.end() && "vertex is not in the cell of its old position");
+  *it = bucket.back();
+  bucket.pop_back();
+  pCells[newCell].push_back(u);
+}
+
+int UniformGrid::nearest(const std::vector<graph::Point2D>& points, const graph::Point2D& point, const double radius) const {
+  if (pCells.empty()) {
+    return namedInts::INVALID;
+  }
+  const size_t centerColumn = column(point.x);
+  const size_t centerRow    = row(point.y);
+  const size_t firstColumn  = (centerColumn > 0 ? centerColumn - 1 : 0);
+  const size_t lastColumn   = std::min(centerColumn + 1, pCellsPerSide - 1);
+  const size_t firstRow     = (centerRow > 0 ? centerRow - 1 : 0);
+  const size_t lastRow      = std::min(centerRow + 1, pCellsPerSide - 1);
+
+  int closest        = namedInts::INVALID;
+  double minDistance = radius;
+  for (size_t r = firstRow; r <= lastRow; ++r) {
+    for (size_t c = firstColumn; c <= lastColumn; ++c) {
+      for (const size_t u : pCells[r * pCellsPerSide + c]) {
+        const double distance = norm2(points[u] - point);
+        if (distance < minDistance) {
+          minDistance = distance;
+          closest     = static_cast<int>(u);
+        }
+      }
+    }
+  }
+  return closest;
+}
+}  // namespace drawing
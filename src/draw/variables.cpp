@@ -28,12 +28,17 @@
 #include "geometry.hpp"
 #include "graph.hpp"
 
+#include "draw/camera.hpp"
+#include "draw/spatialindex.hpp"
+
 #include "utility/utils.hpp"
 
 #include "solve/exactsolver.hpp"
 
 namespace drawing {
 graph::Euclidean EUCLIDEAN;
+UniformGrid VERTEX_GRID;
+Camera CAMERA;
 
 bool SHOW_DEBUG_WINDOW;
 bool SHOW_SETTINGS_WINDOW;
@@ -47,6 +52,8 @@ bool BTSPP_DRAW_BICONNECTED_GRAPH;
 bool BTSPP_DRAW_HAMILTON_PATH;
 bool BTSVPP_DRAW_BICONNECTED_GRAPH;
 bool BTSVPP_DRAW_HAMILTON_PATH;
+
+bool LIVE_APPROXIMATION;
 }  // namespace drawing
 
 namespace input {
@@ -55,12 +62,15 @@ std::unordered_map<int, bool> STATE;
 namespace mouse {
 graph::Point2D MOUSE_LEFT_CLICKED;
 int NODE_IN_MOTION;
+int NODE_HOVERED;
+graph::Point2D LAST_CURSOR_POSITION;
 }  // namespace mouse
 }  // namespace input
 
 namespace mainwindow {
 int HEIGHT;
 int WIDTH;
+unsigned int FRAMES_TO_DRAW;
 }  // namespace mainwindow
 
 namespace solve {
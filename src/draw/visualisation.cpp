@@ -18,6 +18,8 @@
  */
 #include "draw/visualisation.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <iostream>
 #include <memory>
@@ -33,6 +35,8 @@
 #include "draw/events.hpp"
 #include "draw/gui.hpp"
 #include "draw/shader.hpp"
+#include "draw/solverworker.hpp"
+#include "draw/spatialindex.hpp"
 #include "draw/variables.hpp"
 
 #include "solve/exactsolver.hpp"
@@ -55,24 +59,31 @@ static void initDrawingVariables() {
   BTSPP_DRAW_HAMILTON_PATH         = INITIAL_BTSPP_DRAW_HAMILTON_PATH;
   BTSVPP_DRAW_BICONNECTED_GRAPH    = INITIAL_BTSVPP_DRAW_BICONNECTED_GRAPH;
   BTSVPP_DRAW_HAMILTON_PATH        = INITIAL_BTSVPP_DRAW_HAMILTON_PATH;
+  LIVE_APPROXIMATION               = INITIAL_LIVE_APPROXIMATION;
+  CAMERA                           = Camera{};
 }
 
 static void initInputVariables() {
   input::mouse::NODE_IN_MOTION = input::mouse::INITIAL_NODE_IN_MOTION;
+  input::mouse::NODE_HOVERED   = input::mouse::INITIAL_NODE_HOVERED;
 }
 
 static DrawData setUpBufferMemory(const graph::Euclidean& euclidean) {
   drawing::EUCLIDEAN = euclidean;
+  // about one vertex per cell for uniformly distributed vertices, but never smaller than the picking radius
+  const double cellSize = std::max(static_cast<double>(VETREX_RADIUS), 2.0 / std::sqrt(std::max<size_t>(1, euclidean.numberOfNodes())));
+  drawing::VERTEX_GRID  = UniformGrid(drawing::EUCLIDEAN.vertices(), cellSize);
   FloatVertices floatVertices;
   floatVertices.updatePointsfFromEuclidean(drawing::EUCLIDEAN);
 
+  floatVertices.clean();  // the constructor of the vertex buffer uploads everything
+
   std::shared_ptr<VertexBuffer> coordinates = std::make_shared<VertexBuffer>(floatVertices.read(), 2);  // components per vertex
-  std::shared_ptr<ShaderBuffer> tourCoordinates =
-      std::make_shared<ShaderBuffer>(floatVertices.read());                                  // copy vertex coords to shader buffer
-  std::shared_ptr<ShaderBuffer> tour =
-      std::make_shared<ShaderBuffer>(std::vector<uint32_t>(euclidean.numberOfNodes() + 3));  // just allocate memory
+  std::shared_ptr<TourBuffer> tours =
+      std::make_shared<TourBuffer>(euclidean.numberOfNodes() + PATH_OVERHEAD, std::to_underlying(ProblemType::NUMBER_OF_OPTIONS));
+  std::shared_ptr<ElementBuffer> representatives = std::make_shared<ElementBuffer>();
 
-  return DrawData(Buffers{coordinates, tour, tourCoordinates}, floatVertices);
+  return DrawData(Buffers{coordinates, tours, representatives}, floatVertices);
 }
 
 static std::unique_ptr<VertexArray> bindBufferMemory(const Buffers& buffers, const ShaderProgramCollection& programs) {
@@ -80,8 +91,7 @@ static std::unique_ptr<VertexArray> bindBufferMemory(const Buffers& buffers, con
   vao->bind();
   vao->mapBufferToAttribute(buffers.coordinates, programs.drawCircles.id(), "vertexPosition");
   vao->enable(programs.drawCircles.id(), "vertexPosition");
-  vao->bindBufferBase(buffers.tourCoordinates, 0);
-  vao->bindBufferBase(buffers.tour, 1);
+  buffers.coordinates->bindBase(0);  // the shaders read the coordinates also as shader storage buffer
   return vao;
 }
 
@@ -111,7 +121,8 @@ void visualise(const graph::Euclidean& euclidean) {
   const ShaderProgram drawCircles      = collection.linkCircleDrawProgram();
   const ShaderProgram drawPathSegments = collection.linkPathSegementDrawProgram();
   const ShaderProgram drawLineProgram  = collection.linkLineDrawProgram();
-  const ShaderProgramCollection programs(drawCircles, drawPathSegments, drawLineProgram);
+  const ShaderProgram drawEdges        = collection.linkEdgeDrawProgram();
+  const ShaderProgramCollection programs(drawCircles, drawPathSegments, drawLineProgram, drawEdges);
 
   std::shared_ptr<DrawData> drawData = std::make_shared<DrawData>(setUpBufferMemory(euclidean));
   std::unique_ptr<VertexArray> vao   = bindBufferMemory(drawData->buffers, programs);
@@ -122,6 +133,9 @@ void visualise(const graph::Euclidean& euclidean) {
   // set callbacks for keyboard and mouse, must be called before Imgui
   glfwSetKeyCallback(window, keyCallback);
   glfwSetMouseButtonCallback(window, mouseButtonCallback);
+  glfwSetScrollCallback(window, scrollCallback);
+  glfwSetCursorPosCallback(window, cursorPositionCallback);
+  glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
 
   // setup Dear ImGui
   setUpImgui(window, glsl_version);
@@ -130,22 +144,37 @@ void visualise(const graph::Euclidean& euclidean) {
   initDrawingVariables();
   initInputVariables();
 
-  // main loop
-  while (!glfwWindowShouldClose(window)) {
-    // runs only through the loop if something changed
-    glfwPollEvents();
-
-    // handle Events triggert by user input, like keyboard etc.
-    handleEvents(window, drawData);
-
-    // draw the content
-    draw(window, programs, drawData);
-
-    // draw the gui
-    drawImgui(drawData->appearance);
-
-    // swap the drawings to the displayed frame
-    glfwSwapBuffers(window);
+  {
+    // solves instances in the background, finished jobs post events, so the worker is destroyed before the GLFW teardown
+    SolverWorker worker;
+
+    // main loop
+    requestRedraw();
+    while (!glfwWindowShouldClose(window)) {
+      // runs only through the loop if something changed, the callbacks and the solver worker request redraws
+      if (mainwindow::FRAMES_TO_DRAW == 0) {
+        glfwWaitEvents();
+        requestRedraw();  // something woke us up, e.g. ImGui may react to events without a callback of ours
+      }
+      else {
+        glfwPollEvents();
+      }
+
+      // handle Events triggert by user input, like keyboard etc.
+      handleEvents(window, drawData, worker);
+
+      // draw the content
+      draw(window, programs, drawData);
+
+      // draw the gui
+      drawImgui(drawData->appearance, worker);
+
+      // swap the drawings to the displayed frame
+      glfwSwapBuffers(window);
+      if (mainwindow::FRAMES_TO_DRAW > 0) {
+        --mainwindow::FRAMES_TO_DRAW;
+      }
+    }
   }
 
   // clean up Dear ImGui
@@ -0,0 +1,83 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "export/exporter.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "exception/exceptions.hpp"
+
+#include "export/png.hpp"
+#include "export/rasteriser.hpp"
+
+namespace imageexport {
+Exporter::Exporter(const std::string& directory, const unsigned int width, const unsigned int height) :
+  pDirectory(directory), pWidth(width), pHeight(height) {
+  std::error_code error;
+  std::filesystem::create_directories(pDirectory, error);
+  if (error) {
+    throw InvalidFileOperation("Failed to create directory <" + pDirectory + ">: " + error.message());
+  }
+  pThread = std::thread(&Exporter::run, this);
+}
+
+Exporter::~Exporter() {
+  {
+    std::lock_guard<std::mutex> lock(pQueueMutex);
+    pStop = true;
+  }
+  pQueueCondition.notify_one();
+  pThread.join();
+}
+
+void Exporter::submit(Solution&& solution, const std::string& name) {
+  {
+    std::unique_lock<std::mutex> lock(pQueueMutex);
+    pSpaceCondition.wait(lock, [this] { return pQueue.size() < MAX_QUEUED_IMAGES; });
+    pQueue.push_back(Job{std::move(solution), (std::filesystem::path(pDirectory) / name).string()});
+  }
+  pQueueCondition.notify_one();
+}
+
+void Exporter::run() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(pQueueMutex);
+      pQueueCondition.wait(lock, [this] { return pStop || !pQueue.empty(); });
+      if (pQueue.empty()) {
+        return;  // stopped and drained
+      }
+      job = std::move(pQueue.front());
+      pQueue.pop_front();
+    }
+    pSpaceCondition.notify_one();
+    try {
+      writePng(job.filename, render(job.solution, pWidth, pHeight));
+    }
+    catch (const Exception& e) {
+      // one write to std::cerr, printYellow() would write to std::cout, which the solver loop uses at the same time
+      std::cerr << "Warning: Skipped image, " << e.what() << std::endl;
+    }
+  }
+}
+}  // namespace imageexport
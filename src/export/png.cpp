@@ -0,0 +1,242 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "export/png.hpp"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "exception/exceptions.hpp"
+
+#include "export/rasteriser.hpp"
+
+namespace imageexport {
+constexpr std::array<uint8_t, 8> PNG_SIGNATURE{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+constexpr size_t BYTES_PER_PIXEL = 3;
+constexpr size_t MIN_MATCH       = 3;
+constexpr size_t MAX_MATCH       = 258;
+constexpr size_t WINDOW_SIZE     = 32768;
+
+// base values and extra bits of the length codes 257 ... 285 and the distance codes 0 ... 29 of deflate
+constexpr std::array<uint16_t, 29> LENGTH_BASE{3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                               31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<uint8_t, 29> LENGTH_EXTRA{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::array<uint16_t, 30> DISTANCE_BASE{1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                                                 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::array<uint8_t, 30> DISTANCE_EXTRA{0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+static constexpr std::array<uint32_t, 256> crcTable() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t n = 0; n < table.size(); ++n) {
+    uint32_t c = n;
+    for (int k = 0; k < 8; ++k) {
+      c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    }
+    table[n] = c;
+  }
+  return table;
+}
+
+constexpr std::array<uint32_t, 256> CRC_TABLE = crcTable();
+
+/*!
+ * @brief BitWriter packs the bits of a deflate stream, starting with the least significant bit of each byte
+ */
+class BitWriter {
+public:
+  BitWriter(std::vector<uint8_t>& bytes) : pBytes(bytes) {}
+
+  /*!
+   * @brief writes the lowest count bits of value, least significant bit first
+   */
+  void write(const uint32_t value, const unsigned int count) {
+    pBuffer |= static_cast<uint64_t>(value) << pCount;
+    pCount  += count;
+    while (pCount >= 8) {
+      pBytes.push_back(static_cast<uint8_t>(pBuffer));
+      pBuffer >>= 8;
+      pCount   -= 8;
+    }
+  }
+
+  /*!
+   * @brief writes a Huffman code, which deflate stores most significant bit first
+   */
+  void writeCode(const uint32_t code, const unsigned int length) {
+    uint32_t reversed = 0;
+    for (unsigned int i = 0; i < length; ++i) {
+      reversed |= ((code >> i) & 1) << (length - 1 - i);
+    }
+    write(reversed, length);
+  }
+
+  /*!
+   * @brief pads the last byte with zeros
+   */
+  void flush() {
+    if (pCount > 0) {
+      write(0, 8 - pCount);
+    }
+  }
+
+private:
+  std::vector<uint8_t>& pBytes;
+  uint64_t pBuffer    = 0;
+  unsigned int pCount = 0;
+};
+
+static void writeBigEndian(std::vector<uint8_t>& bytes, const uint32_t value) {
+  bytes.push_back(static_cast<uint8_t>(value >> 24));
+  bytes.push_back(static_cast<uint8_t>(value >> 16));
+  bytes.push_back(static_cast<uint8_t>(value >> 8));
+  bytes.push_back(static_cast<uint8_t>(value));
+}
+
+static uint32_t adler32(const std::vector<uint8_t>& data) {
+  constexpr uint32_t MODULUS = 65521;
+  uint32_t a = 1, b = 0;
+  for (const uint8_t byte : data) {
+    a = (a + byte) % MODULUS;
+    b = (b + a) % MODULUS;
+  }
+  return (b << 16) | a;
+}
+
+/*!
+ * @brief writes a literal or a length symbol with the fixed Huffman codes of deflate
+ */
+static void writeSymbol(BitWriter& writer, const unsigned int symbol) {
+  if (symbol < 144) {
+    writer.writeCode(0x30 + symbol, 8);
+  }
+  else if (symbol < 256) {
+    writer.writeCode(0x190 + symbol - 144, 9);
+  }
+  else if (symbol < 280) {
+    writer.writeCode(symbol - 256, 7);
+  }
+  else {
+    writer.writeCode(0xC0 + symbol - 280, 8);
+  }
+}
+
+static void writeMatch(BitWriter& writer, const size_t length, const size_t distance) {
+  size_t code = LENGTH_BASE.size() - 1;
+  while (LENGTH_BASE[code] > length) {
+    --code;
+  }
+  writeSymbol(writer, 257 + code);
+  writer.write(length - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+
+  code = DISTANCE_BASE.size() - 1;
+  while (DISTANCE_BASE[code] > distance) {
+    --code;
+  }
+  writer.writeCode(code, 5);
+  writer.write(distance - DISTANCE_BASE[code], DISTANCE_EXTRA[code]);
+}
+
+static size_t matchLength(const std::vector<uint8_t>& data, const size_t position, const size_t distance) {
+  if (distance > position || distance > WINDOW_SIZE) {
+    return 0;
+  }
+  size_t length = 0;
+  while (length < MAX_MATCH && position + length < data.size() && data[position + length] == data[position + length - distance]) {
+    ++length;
+  }
+  return length;
+}
+
+/*!
+ * @brief compresses data to a zlib stream with a single fixed Huffman block
+ * @details Matches are only searched at the distance of one pixel and of one row, rendered images consist mostly of
+ * runs of the clear colour, which these two distances cover.
+ * @param data filtered image data
+ * @param stride bytes per row including the filter byte
+ */
+static std::vector<uint8_t> compress(const std::vector<uint8_t>& data, const size_t stride) {
+  std::vector<uint8_t> stream{0x78, 0x01};  // deflate with 32 KiB window, no preset dictionary
+  BitWriter writer(stream);
+  writer.write(1, 1);  // last block
+  writer.write(1, 2);  // fixed Huffman codes
+  size_t position = 0;
+  while (position < data.size()) {
+    size_t length = matchLength(data, position, BYTES_PER_PIXEL), distance = BYTES_PER_PIXEL;
+    if (const size_t rowLength = matchLength(data, position, stride); rowLength > length) {
+      length   = rowLength;
+      distance = stride;
+    }
+    if (length >= MIN_MATCH) {
+      writeMatch(writer, length, distance);
+      position += length;
+    }
+    else {
+      writeSymbol(writer, data[position++]);
+    }
+  }
+  writeSymbol(writer, 256);  // end of block
+  writer.flush();
+  writeBigEndian(stream, adler32(data));
+  return stream;
+}
+
+static void writeChunk(std::ofstream& file, const std::string_view type, const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> chunk;
+  chunk.reserve(data.size() + 12);
+  writeBigEndian(chunk, static_cast<uint32_t>(data.size()));
+  chunk.insert(chunk.end(), type.begin(), type.end());
+  chunk.insert(chunk.end(), data.begin(), data.end());
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 4; i < chunk.size(); ++i) {  // the length isn't part of the checksum
+    crc = CRC_TABLE[(crc ^ chunk[i]) & 0xFF] ^ (crc >> 8);
+  }
+  writeBigEndian(chunk, crc ^ 0xFFFFFFFFu);
+  file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+}
+
+void writePng(const std::string& filename, const Image& image) {
+  const size_t rowBytes = BYTES_PER_PIXEL * image.width;
+  std::vector<uint8_t> filtered;
+  filtered.reserve((rowBytes + 1) * image.height);
+  for (size_t row = 0; row < image.height; ++row) {
+    filtered.push_back(0);  // filter type none
+    filtered.insert(filtered.end(), image.pixels.begin() + row * rowBytes, image.pixels.begin() + (row + 1) * rowBytes);
+  }
+
+  std::vector<uint8_t> header;
+  writeBigEndian(header, image.width);
+  writeBigEndian(header, image.height);
+  header.insert(header.end(), {8, 2, 0, 0, 0});  // bit depth, truecolour, deflate, adaptive filtering, no interlace
+
+  std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw InvalidFileOperation("Failed to open <" + filename + ">!");
+  }
+  file.write(reinterpret_cast<const char*>(PNG_SIGNATURE.data()), PNG_SIGNATURE.size());
+  writeChunk(file, "IHDR", header);
+  writeChunk(file, "IDAT", compress(filtered, rowBytes + 1));
+  writeChunk(file, "IEND", {});
+  if (!file) {
+    throw InvalidFileOperation("Failed to write <" + filename + ">!");
+  }
+}
+}  // namespace imageexport
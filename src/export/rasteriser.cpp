@@ -0,0 +1,178 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "export/rasteriser.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// graph library
+#include "geometry.hpp"
+#include "graph.hpp"
+
+#include "draw/definitions.hpp"
+
+#include "solve/definitions.hpp"
+
+namespace imageexport {
+constexpr double MARGIN = 0.05;  // fraction of the image kept free at each border
+
+using Pixel = std::array<uint8_t, 3>;
+
+/*!
+ * @brief Fit maps positions to pixel coordinates, the y axis points downwards in the image
+ */
+struct Fit {
+  double scale;
+  double offsetX;
+  double offsetY;
+
+  graph::Point2D apply(const graph::Point2D& p) const { return graph::Point2D{offsetX + scale * p.x, offsetY - scale * p.y}; }
+};
+
+static Pixel toPixel(const RGBA_COLOUR& colour) {
+  Pixel pixel;
+  for (size_t i = 0; i < pixel.size(); ++i) {
+    pixel[i] = static_cast<uint8_t>(std::lround(255.0f * std::clamp(colour[i], 0.0f, 1.0f)));
+  }
+  return pixel;
+}
+
+static bool closed(const ProblemType type) {
+  return type == ProblemType::BTSP_approx || type == ProblemType::BTSP_exact || type == ProblemType::TSP_exact;
+}
+
+/*!
+ * @brief computes the transformation that centers the bounding box of positions and fits it into the image
+ */
+static Fit fit(const std::vector<graph::Point2D>& positions, const unsigned int width, const unsigned int height) {
+  const auto [minX, maxX] = std::minmax_element(positions.begin(), positions.end(), [](const auto& a, const auto& b) { return a.x < b.x; });
+  const auto [minY, maxY] = std::minmax_element(positions.begin(), positions.end(), [](const auto& a, const auto& b) { return a.y < b.y; });
+  double extent           = std::max(maxX->x - minX->x, maxY->y - minY->y);
+  if (extent <= 0.0) {
+    extent = 1.0;  // a single position or all positions equal
+  }
+  const double scale = (1.0 - 2.0 * MARGIN) * std::min(width, height) / extent;
+  return Fit{scale, 0.5 * width - 0.5 * scale * (minX->x + maxX->x), 0.5 * height + 0.5 * scale * (minY->y + maxY->y)};
+}
+
+static void blend(Image& image, const unsigned int x, const unsigned int y, const Pixel& colour, const double coverage) {
+  uint8_t* pixel = image.pixels.data() + 3 * (static_cast<size_t>(y) * image.width + x);
+  for (size_t i = 0; i < colour.size(); ++i) {
+    pixel[i] = static_cast<uint8_t>(std::lround(pixel[i] + coverage * (colour[i] - pixel[i])));
+  }
+}
+
+static double distanceToSegment(const graph::Point2D& p, const graph::Point2D& a, const graph::Point2D& b) {
+  const double dx     = b.x - a.x;
+  const double dy     = b.y - a.y;
+  const double length = dx * dx + dy * dy;
+  const double t      = length > 0.0 ? std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / length, 0.0, 1.0) : 0.0;
+  return graph::norm2(p - graph::Point2D{a.x + t * dx, a.y + t * dy});
+}
+
+/*!
+ * @brief draws an antialiased segment with round caps
+ * @details Only the pixels in the band around the line through a and b are visited, so that long diagonal segments
+ * don't cost their whole bounding box.
+ * @param image image to draw on
+ * @param a first endpoint in pixel coordinates
+ * @param b second endpoint in pixel coordinates
+ * @param thickness width of the segment in pixels
+ * @param colour colour of the segment
+ */
+static void drawSegment(Image& image, const graph::Point2D& a, const graph::Point2D& b, const double thickness, const Pixel& colour) {
+  const double reach  = 0.5 * thickness + 0.5;  // pixels whose center is further away are not covered
+  const double dx     = b.x - a.x;
+  const double dy     = b.y - a.y;
+  const double length = std::sqrt(dx * dx + dy * dy);
+  const double top    = std::max(0.0, std::floor(std::min(a.y, b.y) - reach));
+  const double bottom = std::min(image.height - 1.0, std::ceil(std::max(a.y, b.y) + reach));
+  for (double y = top; y <= bottom; ++y) {
+    const double centerY = y + 0.5;
+    double left          = std::min(a.x, b.x) - reach;
+    double right         = std::max(a.x, b.x) + reach;
+    if (dy != 0.0) {
+      const double centerX   = a.x + dx * (centerY - a.y) / dy;
+      const double halfWidth = reach * length / std::abs(dy);
+      left                   = std::max(left, centerX - halfWidth);
+      right                  = std::min(right, centerX + halfWidth);
+    }
+    for (double x = std::max(0.0, std::floor(left)); x <= std::min(image.width - 1.0, std::ceil(right)); ++x) {
+      const double coverage = reach - distanceToSegment(graph::Point2D{x + 0.5, centerY}, a, b);
+      if (coverage > 0.0) {
+        blend(image, static_cast<unsigned int>(x), static_cast<unsigned int>(y), colour, std::min(coverage, 1.0));
+      }
+    }
+  }
+}
+
+static void drawDisc(Image& image, const graph::Point2D& center, const double radius, const Pixel& colour) {
+  const double reach = radius + 0.5;
+  for (double y = std::max(0.0, std::floor(center.y - reach)); y <= std::min(image.height - 1.0, std::ceil(center.y + reach)); ++y) {
+    for (double x = std::max(0.0, std::floor(center.x - reach)); x <= std::min(image.width - 1.0, std::ceil(center.x + reach)); ++x) {
+      const double coverage = reach - graph::norm2(graph::Point2D{x + 0.5, y + 0.5} - center);
+      if (coverage > 0.0) {
+        blend(image, static_cast<unsigned int>(x), static_cast<unsigned int>(y), colour, std::min(coverage, 1.0));
+      }
+    }
+  }
+}
+
+Image render(const Solution& solution, const unsigned int width, const unsigned int height) {
+  Image image{width, height, std::vector<uint8_t>(3 * static_cast<size_t>(width) * height)};
+  const Pixel clearColour = toPixel(drawing::INITIAL_CLEAR_COLOUR);
+  for (size_t i = 0; i < image.pixels.size(); i += clearColour.size()) {
+    std::copy(clearColour.begin(), clearColour.end(), image.pixels.begin() + i);
+  }
+  if (solution.positions.empty()) {
+    return image;
+  }
+
+  const Fit transformation = fit(solution.positions, width, height);
+  std::vector<graph::Point2D> points(solution.positions.size());
+  std::transform(solution.positions.begin(), solution.positions.end(), points.begin(), [&](const graph::Point2D& p) {
+    return transformation.apply(p);
+  });
+
+  const Pixel colour     = toPixel(drawing::INITIAL_COLOUR[std::to_underlying(solution.type)]);
+  const double thickness = drawing::INITIAL_THICKNESS[std::to_underlying(solution.type)];
+  for (size_t i = 0; i + 1 < solution.tour.size(); ++i) {
+    drawSegment(image, points[solution.tour[i]], points[solution.tour[i + 1]], thickness, colour);
+  }
+  if (closed(solution.type) && solution.tour.size() > 2) {
+    drawSegment(image, points[solution.tour.back()], points[solution.tour.front()], thickness, colour);
+  }
+  if (solution.bottleneckEdge.u < points.size() && solution.bottleneckEdge.v < points.size()) {
+    drawSegment(image, points[solution.bottleneckEdge.u], points[solution.bottleneckEdge.v],
+                drawing::BOTLLENECK_EDGE_WIDTH_FACTOR * thickness, colour);
+  }
+
+  // the window draws vertices with a radius relative to the half of the view, which the fit maps to the image
+  const double radius      = drawing::VETREX_RADIUS * (1.0 - 2.0 * MARGIN) * 0.5 * std::min(width, height);
+  const Pixel vertexColour = toPixel(drawing::INITIAL_VERTEX_COLOUR);
+  for (const graph::Point2D& point : points) {
+    drawDisc(image, point, radius, vertexColour);
+  }
+  return image;
+}
+}  // namespace imageexport
@@ -0,0 +1,271 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "service.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// graph library
+#include "geometry.hpp"
+#include "graph.hpp"
+
+#include "exception/exceptions.hpp"
+
+#include "solve/approximation.hpp"
+#include "solve/definitions.hpp"
+#include "solve/exactsolver.hpp"
+
+namespace service {
+
+/***********************************************************************************************************************
+ *                                                       input
+ **********************************************************************************************************************/
+
+/*! number of points allocated at once while reading, so that a wrong number of nodes cannot allocate more memory than
+ * the input actually provides */
+static constexpr size_t READ_CHUNK = size_t{1} << 16;
+
+/*! largest number of nodes whose coordinates can be counted in bytes without overflow */
+static constexpr uint64_t MAX_NUMBER_OF_NODES = std::numeric_limits<size_t>::max() / sizeof(graph::Point2D);
+
+/*!
+ * @brief checks the estimated memory of an instance for all problem types against the memory budget
+ * @details The sizes are compared before any estimate is multiplied out, so huge numbers of nodes cannot overflow.
+ * @param memoryBudget memory available for one instance in bytes, 0 if unlimited
+ */
+static bool fitsMemoryBudget(const size_t numberOfNodes, const std::vector<ProblemType>& types, const size_t memoryBudget) {
+  if (memoryBudget == 0) {
+    return true;
+  }
+  if (numberOfNodes > memoryBudget / (2 * sizeof(graph::Point2D))) {
+    return false;  // the double buffered positions alone exceed the budget
+  }
+  for (const ProblemType type : types) {
+    const bool approximation = type == ProblemType::BTSP_approx || type == ProblemType::BTSPP_approx || type == ProblemType::BTSVPP_approx;
+    if (!approximation && numberOfNodes - 1 > memoryBudget / sizeof(double) / numberOfNodes) {
+      return false;  // the costs of the x variables alone exceed the budget
+    }
+    if (approximation && numberOfNodes - 1 > 2 * (memoryBudget / approximation::BYTES_PER_CANDIDATE_EDGE) / numberOfNodes) {
+      return false;  // the candidate edges alone exceed the budget
+    }
+    const size_t estimate = 2 * numberOfNodes * sizeof(graph::Point2D) + (approximation ? approximation::estimateMemory(numberOfNodes, type)
+                                                                                      : exactsolver::estimateMemory(numberOfNodes, type));
+    if (estimate > memoryBudget) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+ * @brief reads the number of nodes as a text token, so that signs and garbage are rejected instead of wrapped around
+ * @return number of nodes, empty at the end of the input
+ */
+static std::optional<uint64_t> readTextNumberOfNodes() {
+  std::string token;
+  if (!(std::cin >> token)) {
+    if (std::cin.eof()) {
+      return std::nullopt;
+    }
+    throw InvalidFileOperation("[SERVICE] Failed to read number of nodes from stdin!");
+  }
+  uint64_t numberOfNodes;
+  const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), numberOfNodes);
+  if (error != std::errc() || end != token.data() + token.size() || numberOfNodes > MAX_NUMBER_OF_NODES) {
+    throw InvalidFileOperation("[SERVICE] Invalid number of nodes <" + token + "> on stdin!");
+  }
+  return numberOfNodes;
+}
+
+static std::optional<uint64_t> readBinaryNumberOfNodes() {
+  uint64_t numberOfNodes;
+  if (!std::cin.read(reinterpret_cast<char*>(&numberOfNodes), sizeof(numberOfNodes))) {
+    if (std::cin.gcount() == 0) {
+      return std::nullopt;
+    }
+    throw InvalidFileOperation("[SERVICE] Failed to read number of nodes from stdin!");
+  }
+  if (numberOfNodes > MAX_NUMBER_OF_NODES) {
+    throw InvalidFileOperation("[SERVICE] Invalid number of nodes " + std::to_string(numberOfNodes) + " on stdin!");
+  }
+  return numberOfNodes;
+}
+
+static std::vector<graph::Point2D> readTextPositions(const size_t numberOfNodes) {
+  std::vector<graph::Point2D> positions;
+  positions.reserve(std::min(numberOfNodes, READ_CHUNK));  // grows with the input actually read
+  graph::Point2D point;
+  for (size_t i = 0; i < numberOfNodes; ++i) {
+    if (!(std::cin >> point.x >> point.y)) {
+      throw InvalidFileOperation("[SERVICE] Unexpected end of instance on stdin!");
+    }
+    positions.push_back(point);
+  }
+  return positions;
+}
+
+static std::vector<graph::Point2D> readBinaryPositions(const size_t numberOfNodes) {
+  std::vector<graph::Point2D> positions;
+  std::vector<double> coordinates(2 * std::min(numberOfNodes, READ_CHUNK));
+  while (positions.size() < numberOfNodes) {
+    const size_t count = std::min(numberOfNodes - positions.size(), READ_CHUNK);
+    if (!std::cin.read(reinterpret_cast<char*>(coordinates.data()), 2 * count * sizeof(double))) {
+      throw InvalidFileOperation("[SERVICE] Unexpected end of instance on stdin!");
+    }
+    for (size_t i = 0; i < count; ++i) {
+      positions.push_back(graph::Point2D{coordinates[2 * i], coordinates[2 * i + 1]});
+    }
+  }
+  return positions;
+}
+
+/*!
+ * @brief consumes the coordinates of a rejected instance, so that the next instance is read from the right position
+ */
+static void skipPositions(const Format format, const size_t numberOfNodes) {
+  if (format == Format::Binary) {
+    for (size_t remaining = numberOfNodes; remaining > 0;) {
+      const size_t count = std::min(remaining, READ_CHUNK);
+      if (!std::cin.ignore(2 * count * sizeof(double)) || std::cin.gcount() != static_cast<std::streamsize>(2 * count * sizeof(double))) {
+        throw InvalidFileOperation("[SERVICE] Unexpected end of instance on stdin!");
+      }
+      remaining -= count;
+    }
+  }
+  else {
+    double coordinate;
+    for (size_t i = 0; i < 2 * numberOfNodes; ++i) {
+      if (!(std::cin >> coordinate)) {
+        throw InvalidFileOperation("[SERVICE] Unexpected end of instance on stdin!");
+      }
+    }
+  }
+}
+
+/*!
+ * @brief reads the next instance
+ * @details Instances that are too small or exceed the memory budget are skipped and reported by InvalidArgument, the
+ * input stays in sync. Malformed input is reported by InvalidFileOperation, after which the position in the input is
+ * lost.
+ * @return instance, empty at the end of the input
+ */
+static std::optional<graph::Euclidean> readInstance(const Format format, const std::vector<ProblemType>& types, const size_t memoryBudget) {
+  const std::optional<uint64_t> numberOfNodes = (format == Format::Binary ? readBinaryNumberOfNodes() : readTextNumberOfNodes());
+  if (!numberOfNodes.has_value()) {
+    return std::nullopt;
+  }
+  if (*numberOfNodes < 3) {
+    skipPositions(format, *numberOfNodes);
+    throw InvalidArgument("[SERVICE] Invalid instance, graph must have at least 3 vertices!");
+  }
+  if (!fitsMemoryBudget(*numberOfNodes, types, memoryBudget)) {
+    skipPositions(format, *numberOfNodes);
+    throw InvalidArgument("[SERVICE] Skipped instance with " + std::to_string(*numberOfNodes) + " nodes, estimated memory exceeds budget!");
+  }
+  return graph::Euclidean(format == Format::Binary ? readBinaryPositions(*numberOfNodes) : readTextPositions(*numberOfNodes));
+}
+
+/***********************************************************************************************************************
+ *                                                       output
+ **********************************************************************************************************************/
+
+static void writeSolution(const ProblemType type, const double objective, const std::vector<size_t>& tour) {
+  std::cout << std::to_underlying(type) << " " << objective;
+  for (const size_t u : tour) {
+    std::cout << " " << u;
+  }
+  std::cout << "\n";
+}
+
+static void writeError(const ProblemType type, const char* message) {
+  std::cout << "error " << std::to_underlying(type) << " " << message << "\n";
+}
+
+static void solve(const graph::Euclidean& euclidean, const ProblemType type, const bool noCrossing) {
+  if (type == ProblemType::BTSP_approx) {
+    const approximation::Result res = approximation::approximateBTSP<approximation::ResultPolicy::Compact>(euclidean);
+    writeSolution(type, res.objective, res.tour);
+  }
+  else if (type == ProblemType::BTSPP_approx) {
+    const approximation::Result res = approximation::approximateBTSPP<approximation::ResultPolicy::Compact>(euclidean);
+    writeSolution(type, res.objective, res.tour);
+  }
+  else if (type == ProblemType::BTSVPP_approx) {
+    const approximation::Result res = approximation::approximateBTSVPP<approximation::ResultPolicy::Compact>(euclidean);
+    writeSolution(type, res.objective, res.tour);
+  }
+  else if (type == ProblemType::BTSP_exact || type == ProblemType::BTSPP_exact || type == ProblemType::TSP_exact) {
+    const exactsolver::Result res = exactsolver::solve(euclidean, type, type == ProblemType::BTSP_exact && noCrossing);
+    writeSolution(type, res.opt, res.tour);
+  }
+  else {
+    throw UnknownType("[SERVICE] Unknown problem type " + std::to_string(std::to_underlying(type)) + "!");
+  }
+}
+
+/***********************************************************************************************************************
+ *                                                    service loop
+ **********************************************************************************************************************/
+
+void serve(const std::vector<ProblemType>& types, const Format format, const bool noCrossing, const size_t memoryBudget) {
+  std::ios_base::sync_with_stdio(false);  // cin and cout are the only streams used for data
+  std::cin.tie(nullptr);                  // reading on the reader thread must not flush cout written by the solver
+
+  const auto startReading = [&]() {
+    return std::async(std::launch::async, [&]() { return readInstance(format, types, memoryBudget); });
+  };
+  std::future<std::optional<graph::Euclidean>> nextInstance = startReading();
+  while (true) {
+    std::optional<graph::Euclidean> instance;
+    try {
+      instance = nextInstance.get();  // no read is pending from here on until the next one is started
+    }
+    catch (const InvalidArgument& error) {  // the instance was skipped, the input is still in sync
+      nextInstance = startReading();
+      for (const ProblemType type : types) {
+        writeError(type, error.what());
+      }
+      std::cout.flush();
+      continue;
+    }
+    if (!instance.has_value()) {
+      return;
+    }
+
+    nextInstance = startReading();  // parse instance k+1 while solving instance k
+    for (const ProblemType type : types) {
+      try {
+        solve(*instance, type, noCrossing);
+      }
+      catch (const std::exception& error) {
+        writeError(type, error.what());
+      }
+    }
+    std::cout.flush();  // hand solutions of this instance over to the consumer
+  }
+}
+}  // namespace service
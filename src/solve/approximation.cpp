@@ -37,6 +37,8 @@
 
 #include "solve/commonfunctions.hpp"
 
+#include "utility/perfcounter.hpp"
+
 namespace approximation {
 
 /***********************************************************************************************************************
@@ -49,11 +51,26 @@ void printInfo(const approximation::Result& res, const ProblemType problemType,
   std::cout << "objective                            : " << res.objective << std::endl;
   std::cout << "lower bound on OPT                   : " << res.lowerBoundOnOPT << std::endl;
   std::cout << "a fortiori guarantee                 : " << res.objective / res.lowerBoundOnOPT << std::endl;
-  std::cout << "edges in biconnected graph           : " << res.biconnectedGraph.numberOfEdges() << std::endl;
+  std::cout << "edges in biconnected graph           : " << res.numberOfEdgesInBiconnectedGraph << std::endl;
   std::cout << "edges in minimally biconnected graph : " << res.numberOfEdgesInMinimallyBiconectedGraph << std::endl;
   if (runtime != -1.0) {
     std::cout << "elapsed time                         : " << runtime << " ms\n";
   }
+  perfcounter::print(std::cout);
+}
+
+/***********************************************************************************************************************
+ *                                                 memory estimation
+ **********************************************************************************************************************/
+
+/*! rough number of bytes per node in all adjacency lists built after the biconnected subgraph is found */
+static constexpr size_t BYTES_PER_NODE = 512;
+
+size_t estimateMemory(const size_t numberOfNodes, const ProblemType problemType) {
+  const size_t numberOfCandidateEdges = numberOfNodes * (numberOfNodes - 1) / 2;
+  const size_t candidateBytes         = numberOfCandidateEdges * BYTES_PER_CANDIDATE_EDGE;
+  const size_t numberOfNodesInGraphs  = (problemType == ProblemType::BTSP_approx ? numberOfNodes : 5 * numberOfNodes + 2);
+  return candidateBytes + numberOfNodesInGraphs * BYTES_PER_NODE;
 }
 
 /***********************************************************************************************************************
@@ -170,6 +187,7 @@ static void prepareForEulertour(graph::AdjacencyListDigraph& digraph) {
  */
 static std::vector<size_t> findEulertour(graph::AdjacencyListDigraph& digraph) {
   prepareForEulertour(digraph);
+  const perfcounter::Scope scope("hierholzer");
   std::vector<size_t> eulertourInGMinus = hierholzer(digraph.undirected());
   return eulertourInGMinus;
 }
@@ -216,9 +234,12 @@ std::vector<size_t> findHamiltonCycleInOpenEarDecomposition(const graph::EarDeco
     tour = std::vector<size_t>(openEars.ears[0].begin(), openEars.ears[0].end() - 1);  // do not repeat first node
   }
   else {
+    perfcounter::Scope scope("construct digraph");
     graph::AdjacencyListDigraph digraph = constructDigraph(openEars, numberOfNodes);
-    std::vector<size_t> tmp             = findEulertour(digraph);
-    tour                                = shortcutToHamiltoncycle(tmp, digraph, numberOfNodes);
+    scope.next("eulertour");  // includes prepareForEulertour(), the nested "hierholzer" stage is counted in both
+    std::vector<size_t> tmp = findEulertour(digraph);
+    scope.next("shortcut");
+    tour = shortcutToHamiltoncycle(tmp, digraph, numberOfNodes);
   }
   assert(tour.size() == numberOfNodes && "Missmatching number of nodes in hamilton cycle!");
   return tour;
@@ -0,0 +1,132 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "solve/chaindecomposition.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// graph library
+#include "graph.hpp"
+
+namespace approximation {
+constexpr uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+
+/*!
+ * @brief CompressedGraph stores the adjacency lists of all nodes back to back
+ */
+struct CompressedGraph {
+  std::vector<size_t> offsets;   /**< neighbours of u are targets[offsets[u]] ... targets[offsets[u + 1] - 1] */
+  std::vector<uint32_t> targets; /**< concatenated adjacency lists */
+
+  uint32_t numberOfNodes() const { return static_cast<uint32_t>(offsets.size() - 1); }
+};
+
+static CompressedGraph compress(const graph::AdjacencyListGraph& graph) {
+  const std::vector<std::vector<size_t>>& adjacencyList = graph.adjacencyList();
+  CompressedGraph compressed;
+  compressed.offsets.resize(adjacencyList.size() + 1);
+  compressed.offsets[0] = 0;
+  for (size_t u = 0; u < adjacencyList.size(); ++u) {
+    compressed.offsets[u + 1] = compressed.offsets[u] + adjacencyList[u].size();
+  }
+  compressed.targets.resize(compressed.offsets.back());
+  for (size_t u = 0; u < adjacencyList.size(); ++u) {
+    std::copy(adjacencyList[u].begin(), adjacencyList[u].end(), compressed.targets.begin() + compressed.offsets[u]);
+  }
+  return compressed;
+}
+
+/*!
+ * @brief DepthFirstSearch holds the result of the search in flat arrays indexed by node
+ */
+struct DepthFirstSearch {
+  std::vector<uint32_t> dfi;    /**< depth first index of every node */
+  std::vector<uint32_t> parent; /**< parent in the depth first search tree, NO_NODE for roots */
+  std::vector<uint32_t> order;  /**< nodes sorted by depth first index */
+};
+
+/*!
+ * @brief iterative depth first search, the stack holds the path from the root to the current node
+ */
+static DepthFirstSearch depthFirstSearch(const CompressedGraph& graph) {
+  const uint32_t numberOfNodes = graph.numberOfNodes();
+  DepthFirstSearch search{std::vector<uint32_t>(numberOfNodes, NO_NODE), std::vector<uint32_t>(numberOfNodes, NO_NODE), {}};
+  search.order.reserve(numberOfNodes);
+  std::vector<size_t> nextEdge(graph.offsets.begin(), graph.offsets.end() - 1);  // position of the next neighbour to visit
+  std::vector<uint32_t> stack;
+  stack.reserve(numberOfNodes);
+
+  for (uint32_t root = 0; root < numberOfNodes; ++root) {
+    if (search.dfi[root] != NO_NODE) {
+      continue;
+    }
+    search.dfi[root] = static_cast<uint32_t>(search.order.size());
+    search.order.push_back(root);
+    stack.push_back(root);
+    while (!stack.empty()) {
+      const uint32_t u = stack.back();
+      if (nextEdge[u] == graph.offsets[u + 1]) {
+        stack.pop_back();  // all neighbours visited
+        continue;
+      }
+      const uint32_t v = graph.targets[nextEdge[u]++];
+      if (search.dfi[v] == NO_NODE) {
+        search.dfi[v]    = static_cast<uint32_t>(search.order.size());
+        search.parent[v] = u;
+        search.order.push_back(v);
+        stack.push_back(v);
+      }
+    }
+  }
+  return search;
+}
+
+graph::EarDecomposition chainDecomposition(const graph::AdjacencyListGraph& graph) {
+  assert(graph.numberOfNodes() < NO_NODE && "Node indices must fit into 32 bit!");
+  const CompressedGraph compressed = compress(graph);
+  const DepthFirstSearch search    = depthFirstSearch(compressed);
+
+  graph::EarDecomposition chains;
+  std::vector<bool> visited(compressed.numberOfNodes(), false);
+  for (const uint32_t u : search.order) {
+    for (size_t i = compressed.offsets[u]; i < compressed.offsets[u + 1]; ++i) {
+      const uint32_t v = compressed.targets[i];
+      if (search.dfi[v] <= search.dfi[u] || search.parent[v] == u) {
+        continue;  // only back edges from u to a descendant start a chain
+      }
+      std::vector<size_t> chain{u, v};
+      visited[u] = true;
+      for (uint32_t w = v; !visited[w]; w = search.parent[w]) {  // climb up to the first node of an earlier chain
+        visited[w] = true;
+        chain.push_back(search.parent[w]);
+      }
+      chains.ears.push_back(std::move(chain));
+    }
+  }
+  std::reverse(chains.ears.begin(), chains.ears.end());  // the graph library stores the first ear last
+  return chains;
+}
+
+void removeTrivialEars(graph::EarDecomposition& ears) {
+  std::erase_if(ears.ears, [](const std::vector<size_t>& ear) { return ear.size() == 2; });
+}
+}  // namespace approximation
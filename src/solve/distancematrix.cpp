@@ -0,0 +1,162 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "solve/distancematrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "exception/exceptions.hpp"
+
+/*! ranks up to 2^24 are exact as float */
+static constexpr size_t MAX_FLOAT_RANKS = size_t{1} << std::numeric_limits<float>::digits;
+/*! every rank is one value of uint16_t */
+static constexpr size_t MAX_UINT16_RANKS = size_t{std::numeric_limits<uint16_t>::max()} + 1;
+/*! larger matrices overflow the number of entries n * (n - 1) / 2 */
+static constexpr int64_t MAX_NUMBER_OF_NODES = int64_t{1} << 32;
+
+/*!
+ * @brief MatrixFile reads the distances below the diagonal of a matrix file, as often as needed
+ */
+class MatrixFile {
+public:
+  explicit MatrixFile(const std::string& filename) : pFilename(filename), pFile(filename) {
+    if (!pFile) {
+      throw InvalidFileOperation("Failed to open <" + filename + ">!");
+    }
+    int64_t numberOfNodes;  // signed, so that a negative number fails instead of wrapping around
+    if (!(pFile >> numberOfNodes) || numberOfNodes < 2 || numberOfNodes > MAX_NUMBER_OF_NODES) {
+      throw InvalidFileOperation("Failed to read the number of nodes from <" + filename + ">, expected an integer in [2, 2^32]!");
+    }
+    pNumberOfNodes = static_cast<size_t>(numberOfNodes);
+    pStart = pFile.tellg();
+  }
+
+  size_t numberOfNodes() const { return pNumberOfNodes; }
+
+  /*!
+   * @brief calls visit with the distance of every edge {u, v} with v < u, row by row
+   */
+  template <typename Visitor>
+  void forEachDistance(Visitor visit) {
+    pFile.clear();
+    pFile.seekg(pStart);
+    double distance;
+    for (size_t u = 0; u < pNumberOfNodes; ++u) {
+      for (size_t v = 0; v < pNumberOfNodes; ++v) {
+        if (!(pFile >> distance) || !std::isfinite(distance) || distance < 0.0) {
+          throw InvalidFileOperation("Failed to read a distance in row " + std::to_string(u) + " of <" + pFilename + ">!");
+        }
+        if (v < u) {
+          visit(static_cast<float>(distance));
+        }
+      }
+    }
+  }
+
+private:
+  std::string pFilename;
+  std::ifstream pFile;
+  size_t pNumberOfNodes;
+  std::streampos pStart; /**< position of the first distance */
+};
+
+/*!
+ * @brief sorted distinct distances of the file
+ * @param maxRanks number of ranks the entries represent exactly, more distinct values are rejected, since merged ranks
+ * would change which tours are bottleneck optimal
+ */
+static std::vector<float> distinctDistances(MatrixFile& file, const size_t maxRanks) {
+  std::vector<float> values;
+  const auto compact = [&values, maxRanks]() {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    if (values.size() > maxRanks) {
+      throw InvalidArgument("[DISTANCE MATRIX] More than " + std::to_string(maxRanks) +
+                            " distinct distances exceed the ranks the entries represent exactly!");
+    }
+  };
+  file.forEachDistance([&](const float distance) {
+    values.push_back(distance);
+    if (values.size() == 2 * maxRanks) {
+      compact();
+    }
+  });
+  compact();
+  return values;
+}
+
+/*!
+ * @brief encodes every distance of the file into one entry
+ */
+template <typename Entry, typename Encoder>
+static std::vector<Entry> encodeDistances(MatrixFile& file, Encoder encode) {
+  const size_t numberOfNodes = file.numberOfNodes();
+  std::vector<Entry> entries;
+  entries.reserve(numberOfNodes * (numberOfNodes - 1) / 2);
+  file.forEachDistance([&](const float distance) { entries.push_back(encode(distance)); });
+  return entries;
+}
+
+template <typename Entry>
+static Entry rank(const std::vector<float>& values, const float distance) {
+  return static_cast<Entry>(std::lower_bound(values.begin(), values.end(), distance) - values.begin());
+}
+
+/*!
+ * @brief maps the distances linearly onto all values of uint16_t
+ */
+static DistanceMatrix<uint16_t> quantiseDistances(MatrixFile& file) {
+  float min = std::numeric_limits<float>::max(), max = 0.0f;
+  file.forEachDistance([&](const float distance) {
+    min = std::min(min, distance);
+    max = std::max(max, distance);
+  });
+  const double scale  = (static_cast<double>(max) - min) / std::numeric_limits<uint16_t>::max();
+  const double factor = (scale > 0.0 ? 1.0 / scale : 0.0);
+  const auto quantise = [min, factor](const float distance) { return static_cast<uint16_t>(std::round(factor * (distance - min))); };
+  std::vector<uint16_t> entries = encodeDistances<uint16_t>(file, quantise);
+  return DistanceMatrix<uint16_t>(file.numberOfNodes(), std::move(entries), min, scale, false);
+}
+
+template <typename Entry>
+DistanceMatrix<Entry> readDistanceMatrix(const std::string& filename, const bool rankTransform) {
+  MatrixFile file(filename);
+  if (rankTransform) {
+    const std::vector<float> values = distinctDistances(file, std::is_same_v<Entry, float> ? MAX_FLOAT_RANKS : MAX_UINT16_RANKS);
+    std::vector<Entry> entries = encodeDistances<Entry>(file, [&values](const float distance) { return rank<Entry>(values, distance); });
+    return DistanceMatrix<Entry>(file.numberOfNodes(), std::move(entries), 0.0, 1.0, true);
+  }
+  if constexpr (std::is_same_v<Entry, float>) {
+    std::vector<float> entries = encodeDistances<float>(file, [](const float distance) { return distance; });
+    return DistanceMatrix<float>(file.numberOfNodes(), std::move(entries), 0.0, 1.0, false);
+  }
+  else {
+    return quantiseDistances(file);
+  }
+}
+
+template DistanceMatrix<float> readDistanceMatrix(const std::string& filename, const bool rankTransform);
+template DistanceMatrix<uint16_t> readDistanceMatrix(const std::string& filename, const bool rankTransform);
@@ -0,0 +1,71 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "solve/edgeranks.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+// graph library
+#include "graph.hpp"
+
+#include "solve/commonfunctions.hpp"
+
+EdgeRanks::EdgeRanks(const graph::Euclidean& euclidean) :
+  pNumberOfNodes(euclidean.numberOfNodes()), pNumberOfRanks(0), pRanks(pNumberOfNodes * (pNumberOfNodes - 1) / 2) {
+  std::vector<double> squaredLengths(pRanks.size());
+  for (size_t u = 1; u < pNumberOfNodes; ++u) {
+    for (size_t v = 0; v < u; ++v) {
+      squaredLengths[triangularIndex(u, v)] = squaredDistance(euclidean, u, v);
+    }
+  }
+  assignRanks(squaredLengths);
+}
+
+template <typename Entry>
+EdgeRanks::EdgeRanks(const DistanceMatrix<Entry>& matrix) :
+  pNumberOfNodes(matrix.numberOfNodes()), pNumberOfRanks(0), pRanks(pNumberOfNodes * (pNumberOfNodes - 1) / 2) {
+  std::vector<Entry> entries(pRanks.size());
+  for (size_t u = 1; u < pNumberOfNodes; ++u) {
+    for (size_t v = 0; v < u; ++v) {
+      entries[triangularIndex(u, v)] = matrix.entry(u, v);
+    }
+  }
+  assignRanks(entries);
+}
+
+template EdgeRanks::EdgeRanks(const DistanceMatrix<float>& matrix);
+template EdgeRanks::EdgeRanks(const DistanceMatrix<uint16_t>& matrix);
+
+template <typename Key>
+void EdgeRanks::assignRanks(const std::vector<Key>& keys) {
+  std::vector<uint32_t> order(pRanks.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) { return keys[a] < keys[b]; });
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (i > 0 && keys[order[i]] != keys[order[i - 1]]) {
+      ++pNumberOfRanks;
+    }
+    pRanks[order[i]] = pNumberOfRanks;
+  }
+  if (!order.empty()) {
+    ++pNumberOfRanks;
+  }
+}
@@ -30,11 +30,15 @@
 
 #include "solve/definitions.hpp"
 
-graph::Euclidean generateEuclideanDistanceGraph(unsigned int numOfNodes, bool surpressSeed) {
+std::array<uint_fast32_t, SEED_LENGTH> generateSeed() {
   std::array<uint_fast32_t, SEED_LENGTH> randomData;
   std::random_device src;
   std::generate(randomData.begin(), randomData.end(), std::ref(src));
-  return generateEuclideanDistanceGraph(numOfNodes, randomData, surpressSeed);
+  return randomData;
+}
+
+graph::Euclidean generateEuclideanDistanceGraph(unsigned int numOfNodes, bool surpressSeed) {
+  return generateEuclideanDistanceGraph(numOfNodes, generateSeed(), surpressSeed);
 }
 
 graph::Euclidean generateEuclideanDistanceGraph(unsigned int numOfNodes,
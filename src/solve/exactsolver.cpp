@@ -18,9 +18,13 @@
  */
 #include "solve/exactsolver.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -34,6 +38,11 @@
 #include "exception/exceptions.hpp"
 
 #include "solve/commonfunctions.hpp"
+#include "solve/distancematrix.hpp"
+#include "solve/edgeranks.hpp"
+#include "solve/heldkarp.hpp"
+
+#include "utility/perfcounter.hpp"
 
 namespace exactsolver {
 
@@ -41,17 +50,21 @@ using Entry = Eigen::Triplet<double>;
 
 static constexpr double M_INFINITY = 1e32;
 
+/*! rough factor between the size of the model and HiGHS' peak memory (presolved copy, row-wise matrix, factorization) */
+static constexpr size_t HIGHS_MEMORY_FACTOR = 4;
+
 /***********************************************************************************************************************
  *                                                  output function
  **********************************************************************************************************************/
 
 void printInfo(const exactsolver::Result& res, const ProblemType problemType, const double runtime) {
   std::cout << "-------------------------------------------------------\n";
-  std::cout << "Solved an instance of " << problemType << " using HiGHS library." << std::endl;
+  std::cout << "Solved an instance of " << problemType << " exactly." << std::endl;
   std::cout << "OPT                                  : " << res.opt << std::endl;
   if (runtime != -1.0) {
     std::cout << "elapsed time                         : " << runtime << " ms\n";
   }
+  perfcounter::print(std::cout);
 }
 
 /***********************************************************************************************************************
@@ -92,11 +105,41 @@ private:
   const ProblemType pType;
 };
 
-static void setTSPcost(HighsModel& model, const Index& index, const graph::Euclidean& euclidean, const size_t numberOfNodes) {
+/*!
+ * @brief counts the non zero entries in the constraint matrix without anti crossing constraints
+ * @param index index of the instance
+ * @param numberOfNodes number of nodes in the graph
+ * @return number of non zero entries
+ */
+static size_t numberOfNonZeros(const Index& index, const size_t numberOfNodes) {
+  const size_t xEntries = 2 * numberOfNodes * (numberOfNodes - 1);  // every x variable appears in one in and one out constraint
+  const size_t uEntries = 3 * index.uConstraints();                // u_i, u_j and x_ij per constraint
+  const size_t cEntries = 2 * index.cConstraints();                // c and x_ij per constraint
+  return xEntries + uEntries + cEntries;
+}
+
+size_t estimateMemory(const size_t numberOfNodes, const ProblemType problemType) {
+  const Index index(numberOfNodes, problemType);
+  const size_t nonZeros = numberOfNonZeros(index, numberOfNodes);
+
+  // column compressed matrix, cost, bounds and integrality of variables, bounds of constraints
+  const size_t modelBytes = nonZeros * (sizeof(double) + sizeof(HighsInt)) +
+                            index.numVariables() * (3 * sizeof(double) + sizeof(HighsVarType) + sizeof(HighsInt)) +
+                            index.numConstraints() * 2 * sizeof(double);
+  // triplets and the eigen matrix including its temporary transposed copy, while the model is assembled
+  const size_t assemblyBytes = nonZeros * (sizeof(Entry) + 2 * (sizeof(double) + sizeof(int)));
+  // edge ranks of bottleneck problems, one per c constraint pair, alive while the coefficients of the copy are set
+  const size_t rankBytes = index.cConstraints() / 2 * sizeof(uint32_t);
+  // the cached structure stays alive next to the assembly, its copy and the copies made by HiGHS
+  return modelBytes + std::max({assemblyBytes, modelBytes + rankBytes, HIGHS_MEMORY_FACTOR * modelBytes});
+}
+
+template <typename G>
+static void setTSPcost(HighsModel& model, const Index& index, const G& completeGraph, const size_t numberOfNodes) {
   model.lp_.col_cost_.resize(model.lp_.num_col_);
   for (size_t j = 0; j < numberOfNodes; ++j) {
     for (size_t i = j + 1; i < numberOfNodes; ++i) {
-      const double dist                          = euclidean.weight(i, j);
+      const double dist                          = completeGraph.weight(i, j);
       model.lp_.col_cost_[index.variableX(i, j)] = dist;
       model.lp_.col_cost_[index.variableX(j, i)] = dist;  // exploiting symmetry
     }
@@ -201,19 +244,45 @@ static void setMillerTuckerZemlinMatrix(std::vector<Entry>& entries, const Index
   }
 }
 
-static void setCConstraints(std::vector<Entry>& entries, const Index& index, const graph::Euclidean& euclidean) {
-  const size_t numberOfNodes = euclidean.numberOfNodes();
+/*!
+ * @brief sets the pattern of c >= rank(i,j) * x_ij for all edges
+ * @details The coefficients of x_ij depend on the instance and are set by setCCoefficients(), -1 is a placeholder that
+ * keeps the entries in the sparse matrix.
+ */
+static void setCConstraints(std::vector<Entry>& entries, const Index& index, const size_t numberOfNodes) {
   for (size_t j = 0; j < numberOfNodes; ++j) {
     for (size_t i = j + 1; i < numberOfNodes; ++i) {
-      const double dist = euclidean.weight(i, j);
-      entries.push_back(Entry(index.constraintC(i, j), index.variableX(i, j), -dist));
+      entries.push_back(Entry(index.constraintC(i, j), index.variableX(i, j), -1.0));
       entries.push_back(Entry(index.constraintC(i, j), index.variableC(), 1.0));
-      entries.push_back(Entry(index.constraintC(j, i), index.variableX(j, i), -dist));  // exploit symmetry
+      entries.push_back(Entry(index.constraintC(j, i), index.variableX(j, i), -1.0));  // exploit symmetry
       entries.push_back(Entry(index.constraintC(j, i), index.variableC(), 1.0));
     }
   }
 }
 
+/*!
+ * @brief sets the coefficient of x_ij in c >= rank(i,j) * x_ij to -rank(i,j) in the compressed matrix
+ * @details The ranks order the edges like their lengths, so the optimal tours are the same as with lengths as
+ * coefficients, but the coefficients are small integers and no square root is computed. The row indices of every
+ * column are sorted, so the entry of the c constraint is found by binary search.
+ */
+static void setCCoefficients(HighsModel& model, const Index& index, const EdgeRanks& ranks) {
+  const size_t numberOfNodes = ranks.numberOfNodes();
+  HighsSparseMatrix& matrix  = model.lp_.a_matrix_;
+  const auto setCoefficient  = [&matrix](const size_t column, const size_t row, const double value) {
+    const auto first = matrix.index_.begin() + matrix.start_[column];
+    const auto entry = std::lower_bound(first, matrix.index_.begin() + matrix.start_[column + 1], static_cast<HighsInt>(row));
+    matrix.value_[entry - matrix.index_.begin()] = value;
+  };
+  for (size_t j = 0; j < numberOfNodes; ++j) {
+    for (size_t i = j + 1; i < numberOfNodes; ++i) {
+      const double rank = ranks.rank(i, j);
+      setCoefficient(index.variableX(i, j), index.constraintC(i, j), -rank);
+      setCoefficient(index.variableX(j, i), index.constraintC(j, i), -rank);  // exploit symmetry
+    }
+  }
+}
+
 static size_t setAntiCrossingConstraints(std::vector<Entry>& entries, const Index& index, const graph::Euclidean& euclidean) {
   const size_t numberOfNodes = euclidean.numberOfNodes();
   size_t row                 = index.numConstraints();
@@ -248,26 +317,27 @@ static void forbidCrossing(HighsModel& model, std::vector<Entry>& entries, const
   model.lp_.num_row_ += numOfAntiCrossingConstraints;
 }
 
-Result solve(const graph::Euclidean& euclidean, const ProblemType problemType, const bool noCrossing) {
-  const size_t numberOfNodes = euclidean.numberOfNodes();
-  const Index index(numberOfNodes, problemType);
-
-  HighsModel model;
+/*!
+ * @brief sets everything of the model that does not depend on the distances
+ * @details The costs of TSP and the coefficients of the c constraints are left to setTSPcost() and setCCoefficients().
+ */
+static void setStructure(HighsModel& model,
+                         std::vector<Entry>& entries,
+                         const Index& index,
+                         const size_t numberOfNodes,
+                         const ProblemType problemType) {
   model.lp_.num_col_ = index.numVariables();
   model.lp_.num_row_ = index.numConstraints();  // may be changed later on by forbidCrossing()
   model.lp_.sense_   = ObjSense::kMinimize;
   model.lp_.offset_  = 0;                       // offset has no effect on optimization
 
-  std::vector<Entry> entries;
+  entries.reserve(numberOfNonZeros(index, numberOfNodes));
   if (problemType == ProblemType::BTSP_exact) {
     setBTSPcost(model, index);
     setMillerTuckerZemlinBounds(model, index, numberOfNodes);
     setMillerTuckerZemlinMatrix(entries, index, numberOfNodes);
     setCBounds(model, index);
-    setCConstraints(entries, index, euclidean);
-    if (noCrossing) {
-      forbidCrossing(model, entries, euclidean, index);
-    }
+    setCConstraints(entries, index, numberOfNodes);
   }
   else if (problemType == ProblemType::BTSPP_exact) {
     setBTSPcost(model, index);
@@ -275,17 +345,21 @@ Result solve(const graph::Euclidean& euclidean, const ProblemType problemType, c
     setPathBounds(model, index);
     setMillerTuckerZemlinMatrix(entries, index, numberOfNodes);
     setCBounds(model, index);
-    setCConstraints(entries, index, euclidean);
+    setCConstraints(entries, index, numberOfNodes);
   }
   else if (problemType == ProblemType::TSP_exact) {
-    entries.reserve((numberOfNodes - 1) * index.xConstraints() + 3 * index.uConstraints());
-    setTSPcost(model, index, euclidean, numberOfNodes);          // set cost function
     setMillerTuckerZemlinBounds(model, index, numberOfNodes);    // set bounds on variables and constraints
     setMillerTuckerZemlinMatrix(entries, index, numberOfNodes);  // set left hand side of constraints
   }
+}
 
+/*!
+ * @brief copies the entries into the column compressed matrix of the model and releases them
+ */
+static void compressMatrix(HighsModel& model, std::vector<Entry>& entries) {
   Eigen::SparseMatrix<double> A(model.lp_.num_row_, model.lp_.num_col_);
   A.setFromTriplets(entries.begin(), entries.end());
+  std::vector<Entry>().swap(entries);  // release triplets before the model is copied
 
   // copy data from eigen sparse matrix into HiGHs sparse matrix
   model.lp_.a_matrix_.format_ = MatrixFormat::kColwise;                                    // use column compressed storage order
@@ -293,13 +367,115 @@ Result solve(const graph::Euclidean& euclidean, const ProblemType problemType, c
   model.lp_.a_matrix_.start_.push_back(A.nonZeros());                                      // add number of nonZeros in the end
   model.lp_.a_matrix_.index_.assign(A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros());  // copy inner indices
   model.lp_.a_matrix_.value_.assign(A.valuePtr(), A.valuePtr() + A.nonZeros());            // copy values
+}
+
+/*!
+ * @brief ModelStructure is the model of the last number of nodes and problem type solved on this thread
+ */
+struct ModelStructure {
+  size_t numberOfNodes    = 0;
+  ProblemType problemType = ProblemType::NUMBER_OF_OPTIONS;
+  HighsModel model;
+};
+
+/*!
+ * @brief structure of the model for the number of nodes and problem type
+ * @details Repeated solves of the same size only copy the cached model instead of sorting the triplets again. Only one
+ * model is kept per thread, so the memory stays bounded when the size changes.
+ */
+static const HighsModel& cachedStructure(const Index& index, const size_t numberOfNodes, const ProblemType problemType) {
+  thread_local ModelStructure cache;
+  if (cache.numberOfNodes != numberOfNodes || cache.problemType != problemType) {
+    cache.model = HighsModel();
+    std::vector<Entry> entries;
+    setStructure(cache.model, entries, index, numberOfNodes, problemType);
+    compressMatrix(cache.model, entries);
+    cache.numberOfNodes = numberOfNodes;
+    cache.problemType   = problemType;
+  }
+  return cache.model;
+}
 
+/*!
+ * @brief structure of the model with anti crossing constraints
+ * @details The anti crossing constraints depend on the positions, so this model is assembled for every instance.
+ */
+static HighsModel crossingFreeStructure(const graph::Euclidean& euclidean, const Index& index, const ProblemType problemType) {
+  HighsModel model;
+  std::vector<Entry> entries;
+  setStructure(model, entries, index, euclidean.numberOfNodes(), problemType);
+  forbidCrossing(model, entries, euclidean, index);
+  compressMatrix(model, entries);
+  return model;
+}
+
+/*!
+ * @brief lets HiGHS poll interrupted in its simplex, interior point and branch and bound loops
+ * @details interrupted must outlive the run of highs.
+ */
+static void setInterruptCallback(Highs& highs, const std::function<bool()>& interrupted) {
+  const auto callback = [](const int, const std::string&, const HighsCallbackDataOut*, HighsCallbackDataIn* dataIn, void* userData) {
+    if (dataIn != nullptr && (*static_cast<const std::function<bool()>*>(userData))()) {
+      dataIn->user_interrupt = true;
+    }
+  };
+  highs.setCallback(callback, const_cast<std::function<bool()>*>(&interrupted));
+  highs.startCallback(kCallbackSimplexInterrupt);
+  highs.startCallback(kCallbackIpmInterrupt);
+  highs.startCallback(kCallbackMipInterrupt);
+}
+
+/*!
+ * @brief builds the MTZ model of completeGraph and solves it with HiGHS
+ * @details Instances with at most heldkarp::MAX_NODES nodes are solved by the dynamic program instead, unless crossings
+ * are forbidden. Crossings can only be forbidden in euclidean graphs, for all other graphs noCrossing must be false.
+ * The run of HiGHS is abandoned with Interrupted once interrupted returns true, an empty function never interrupts.
+ */
+template <typename G>
+static Result solveModel(const G& completeGraph,
+                         const ProblemType problemType,
+                         const bool noCrossing,
+                         const std::function<bool()>& interrupted = {}) {
+  const size_t numberOfNodes = completeGraph.numberOfNodes();
+  if (numberOfNodes <= heldkarp::MAX_NODES && !noCrossing) {
+    return heldkarp::solve(completeGraph, problemType);  // the dynamic program is faster than building the model
+  }
+  const Index index(numberOfNodes, problemType);
+
+  perfcounter::Scope scope("build model");
+  HighsModel model;
+  if (noCrossing) {
+    if constexpr (std::is_same_v<G, graph::Euclidean>) {  // only euclidean graphs have crossings
+      model = crossingFreeStructure(completeGraph, index, problemType);
+    }
+  }
+  else {
+    model = cachedStructure(index, numberOfNodes, problemType);
+  }
+
+  if (problemType == ProblemType::BTSP_exact || problemType == ProblemType::BTSPP_exact) {
+    const EdgeRanks ranks(completeGraph);  // bottleneck objectives only depend on the order of the edges
+    setCCoefficients(model, index, ranks);
+  }
+  else if (problemType == ProblemType::TSP_exact) {
+    setTSPcost(model, index, completeGraph, numberOfNodes);
+  }
+
+  scope.next("pass model");
   Highs highs;
   highs.setOptionValue("output_flag", false);
-  [[maybe_unused]] HighsStatus return_status = highs.passModel(model);
+  if (interrupted) {
+    setInterruptCallback(highs, interrupted);
+  }
+  [[maybe_unused]] HighsStatus return_status = highs.passModel(std::move(model));  // HiGHS takes the model by value
   assert(return_status == HighsStatus::kOk);
 
+  scope.next("highs run");
   return_status = highs.run();  // solve instance
+  scope.stop();
+  if (highs.getModelStatus() == HighsModelStatus::kInterrupt) {
+    throw Interrupted("[SOLVE] HiGHS was interrupted.");
+  }
   assert(return_status == HighsStatus::kOk);
 
   [[maybe_unused]] const HighsModelStatus& model_status = highs.getModelStatus();
@@ -315,11 +491,14 @@ Result solve(const graph::Euclidean& euclidean, const ProblemType problemType, c
     tour[std::round(solution.col_value[index.variableU(i)]) + 1] = i;
   }
 
+  // the objective of bottleneck problems is a rank, the length is only computed for the bottleneck edge
   if (problemType == ProblemType::BTSP_exact) {
-    return Result{tour, info.objective_function_value, findBottleneck(euclidean, tour, true)};
+    const graph::Edge bottleneckEdge = findBottleneck(completeGraph, tour, true);
+    return Result{tour, completeGraph.weight(bottleneckEdge), bottleneckEdge};
   }
   else if (problemType == ProblemType::BTSPP_exact) {
-    return Result{tour, info.objective_function_value, findBottleneck(euclidean, tour, false)};
+    const graph::Edge bottleneckEdge = findBottleneck(completeGraph, tour, false);
+    return Result{tour, completeGraph.weight(bottleneckEdge), bottleneckEdge};
   }
   else if (problemType == ProblemType::TSP_exact) {
     return Result{
@@ -332,4 +511,19 @@ Result solve(const graph::Euclidean& euclidean, const ProblemType problemType, c
     throw UnknownType("[SOLVE] Unknown problem type.");
   }
 }
+
+Result solve(const graph::Euclidean& euclidean,
+             const ProblemType problemType,
+             const bool noCrossing,
+             const std::function<bool()>& interrupted) {
+  return solveModel(euclidean, problemType, noCrossing, interrupted);
+}
+
+Result solve(const DistanceMatrix<float>& matrix, const ProblemType problemType) {
+  return solveModel(matrix, problemType, false);
+}
+
+Result solve(const DistanceMatrix<uint16_t>& matrix, const ProblemType problemType) {
+  return solveModel(matrix, problemType, false);
+}
 }  // namespace exactsolver
@@ -0,0 +1,262 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "solve/heldkarp.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#endif
+
+// graph library
+#include "graph.hpp"
+
+#include "exception/exceptions.hpp"
+
+#include "solve/commonfunctions.hpp"
+#include "solve/distancematrix.hpp"
+#include "solve/edgeranks.hpp"
+#include "solve/exactsolver.hpp"
+
+#include "utility/perfcounter.hpp"
+
+namespace heldkarp {
+
+/*!
+ * @brief (min, +) semiring of tour lengths
+ */
+struct Length {
+  using Cost                     = double;
+  static constexpr Cost INFINITE = std::numeric_limits<double>::infinity();
+  static Cost combine(const Cost a, const Cost b) { return a + b; }
+};
+
+/*!
+ * @brief (min, max) semiring of bottlenecks, costs are edge ranks
+ */
+struct Bottleneck {
+  using Cost                     = uint32_t;
+  static constexpr Cost INFINITE = std::numeric_limits<uint32_t>::max();
+  static Cost combine(const Cost a, const Cost b) { return std::max(a, b); }
+};
+
+/*! number of entries per subset in the table, a multiple of the lanes of 256 bit registers */
+constexpr size_t STRIDE = 16;
+static_assert(MAX_NODES - 1 <= STRIDE, "every node but the start needs an entry per subset");
+
+/*!
+ * @brief costs of the edges in the layout of the table
+ * @details Node i > 0 is represented by bit i - 1. Entries beyond the last node are INFINITE, so that they never win.
+ */
+template <typename Semiring>
+struct Weights {
+  size_t numberOfBits;
+  std::vector<typename Semiring::Cost> edges;     /**< cost of {i + 1, j + 1} at i * STRIDE + j */
+  std::vector<typename Semiring::Cost> fromStart; /**< cost of {0, i + 1} at i */
+};
+
+template <typename Semiring, typename CostFunction>
+static Weights<Semiring> makeWeights(const size_t numberOfNodes, CostFunction cost) {
+  const size_t numberOfBits = numberOfNodes - 1;
+  Weights<Semiring> weights{numberOfBits, std::vector<typename Semiring::Cost>(numberOfBits * STRIDE, Semiring::INFINITE),
+                            std::vector<typename Semiring::Cost>(numberOfBits)};
+  for (size_t i = 0; i < numberOfBits; ++i) {
+    weights.fromStart[i] = cost(0, i + 1);
+    for (size_t j = 0; j < numberOfBits; ++j) {
+      if (i != j) {
+        weights.edges[i * STRIDE + j] = cost(i + 1, j + 1);
+      }
+    }
+  }
+  return weights;
+}
+
+/*!
+ * @brief best cost of extending one of the paths of a subset by an edge to the same node
+ * @param previous costs of the paths through the subset ending in each node, INFINITE for nodes outside the subset
+ * @param edges costs of the edges from each node to the new end
+ */
+template <typename Semiring>
+static typename Semiring::Cost bestExtension(const typename Semiring::Cost* previous, const typename Semiring::Cost* edges) {
+  typename Semiring::Cost best = Semiring::INFINITE;
+  for (size_t j = 0; j < STRIDE; ++j) {
+    best = std::min(best, Semiring::combine(previous[j], edges[j]));
+  }
+  return best;
+}
+
+#if defined(__AVX2__)
+template <>
+Length::Cost bestExtension<Length>(const Length::Cost* previous, const Length::Cost* edges) {
+  __m256d best = _mm256_set1_pd(Length::INFINITE);
+  for (size_t j = 0; j < STRIDE; j += 4) {
+    best = _mm256_min_pd(best, _mm256_add_pd(_mm256_loadu_pd(previous + j), _mm256_loadu_pd(edges + j)));
+  }
+  const __m128d half = _mm_min_pd(_mm256_castpd256_pd128(best), _mm256_extractf128_pd(best, 1));
+  return _mm_cvtsd_f64(_mm_min_sd(half, _mm_unpackhi_pd(half, half)));
+}
+
+template <>
+Bottleneck::Cost bestExtension<Bottleneck>(const Bottleneck::Cost* previous, const Bottleneck::Cost* edges) {
+  __m256i best = _mm256_set1_epi32(-1);  // all bits set is INFINITE
+  for (size_t j = 0; j < STRIDE; j += 8) {
+    const __m256i path = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(previous + j));
+    const __m256i edge = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(edges + j));
+    best               = _mm256_min_epu32(best, _mm256_max_epu32(path, edge));
+  }
+  __m128i half = _mm_min_epu32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+  half         = _mm_min_epu32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+  half         = _mm_min_epu32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+  return static_cast<Bottleneck::Cost>(_mm_cvtsi128_si32(half));
+}
+#endif
+
+/*!
+ * @brief fills the table of best paths
+ * @details Entry S * STRIDE + k is the best cost of a path starting in node 0, visiting exactly the nodes of S and
+ * ending in the node of bit k. Every proper subset of S is a smaller number than S, so increasing order is valid.
+ */
+template <typename Semiring>
+static std::vector<typename Semiring::Cost> fillTable(const Weights<Semiring>& weights) {
+  const size_t numberOfSubsets = size_t{1} << weights.numberOfBits;
+  std::vector<typename Semiring::Cost> table(numberOfSubsets * STRIDE, Semiring::INFINITE);
+  for (size_t k = 0; k < weights.numberOfBits; ++k) {
+    table[(size_t{1} << k) * STRIDE + k] = weights.fromStart[k];
+  }
+  for (size_t subset = 3; subset < numberOfSubsets; ++subset) {
+    if (std::has_single_bit(subset)) {
+      continue;
+    }
+    for (size_t bits = subset; bits != 0; bits &= bits - 1) {
+      const size_t k             = std::countr_zero(bits);
+      const size_t previous      = subset ^ (size_t{1} << k);
+      table[subset * STRIDE + k] = bestExtension<Semiring>(&table[previous * STRIDE], &weights.edges[k * STRIDE]);
+    }
+  }
+  return table;
+}
+
+/*!
+ * @brief reconstructs the path of the table entry by searching the predecessor that attains each cost
+ * @param last bit of the last node of the path through all nodes
+ * @return path starting in node 0 and ending in the node of last
+ */
+template <typename Semiring>
+static std::vector<size_t> reconstruct(const std::vector<typename Semiring::Cost>& table, const Weights<Semiring>& weights, size_t last) {
+  std::vector<size_t> tour;
+  tour.reserve(weights.numberOfBits + 1);
+  tour.push_back(last + 1);
+  for (size_t subset = (size_t{1} << weights.numberOfBits) - 1; !std::has_single_bit(subset);) {
+    const size_t previous = subset ^ (size_t{1} << last);
+    for (size_t bits = previous; bits != 0; bits &= bits - 1) {
+      const size_t j = std::countr_zero(bits);
+      if (Semiring::combine(table[previous * STRIDE + j], weights.edges[last * STRIDE + j]) == table[subset * STRIDE + last]) {
+        last = j;
+        break;
+      }
+    }
+    subset = previous;
+    tour.push_back(last + 1);
+  }
+  tour.push_back(0);
+  std::reverse(tour.begin(), tour.end());
+  return tour;
+}
+
+/*!
+ * @brief finds an optimal cycle through all nodes
+ * @param optimum is set to the cost of the cycle
+ */
+template <typename Semiring>
+static std::vector<size_t> optimalCycle(const Weights<Semiring>& weights, typename Semiring::Cost& optimum) {
+  const std::vector<typename Semiring::Cost> table = fillTable(weights);
+  const size_t full                                = (size_t{1} << weights.numberOfBits) - 1;
+  size_t last                                      = 0;
+  optimum                                          = Semiring::INFINITE;
+  for (size_t k = 0; k < weights.numberOfBits; ++k) {
+    const typename Semiring::Cost cost = Semiring::combine(table[full * STRIDE + k], weights.fromStart[k]);
+    if (cost < optimum) {
+      optimum = cost;
+      last    = k;
+    }
+  }
+  return reconstruct(table, weights, last);
+}
+
+/*!
+ * @brief finds an optimal path from node 0 to node 1 through all nodes
+ */
+template <typename Semiring>
+static std::vector<size_t> optimalPath(const Weights<Semiring>& weights) {
+  return reconstruct(fillTable(weights), weights, 0);  // bit 0 is node 1
+}
+
+template <typename G>
+static exactsolver::Result solveInstance(const G& completeGraph, const ProblemType problemType) {
+  const size_t numberOfNodes = completeGraph.numberOfNodes();
+  if (numberOfNodes < 2 || numberOfNodes > MAX_NODES) {
+    throw InvalidArgument("[HELD KARP] Instance with " + std::to_string(numberOfNodes) + " nodes is out of range!");
+  }
+  perfcounter::Scope scope("held karp");
+  if (problemType == ProblemType::TSP_exact) {
+    const auto weights = makeWeights<Length>(numberOfNodes, [&](const size_t u, const size_t v) { return completeGraph.weight(u, v); });
+    double length;
+    std::vector<size_t> tour = optimalCycle(weights, length);
+    return exactsolver::Result{
+        std::move(tour),
+        length,
+        graph::Edge{0, 0}
+    };
+  }
+  if (problemType == ProblemType::BTSP_exact || problemType == ProblemType::BTSPP_exact) {
+    const bool isCycle = problemType == ProblemType::BTSP_exact;
+    const EdgeRanks ranks(completeGraph);  // bottlenecks only depend on the order of the edges
+    const auto weights = makeWeights<Bottleneck>(numberOfNodes, [&](const size_t u, const size_t v) { return ranks.rank(u, v); });
+    std::vector<size_t> tour;
+    if (isCycle) {
+      Bottleneck::Cost bottleneckRank;
+      tour = optimalCycle(weights, bottleneckRank);
+    }
+    else {
+      tour = optimalPath(weights);
+    }
+    const graph::Edge bottleneckEdge = findBottleneck(completeGraph, tour, isCycle);
+    return exactsolver::Result{std::move(tour), completeGraph.weight(bottleneckEdge), bottleneckEdge};
+  }
+  throw UnknownType("[HELD KARP] Unknown problem type.");
+}
+
+exactsolver::Result solve(const graph::Euclidean& euclidean, const ProblemType problemType) {
+  return solveInstance(euclidean, problemType);
+}
+
+exactsolver::Result solve(const DistanceMatrix<float>& matrix, const ProblemType problemType) {
+  return solveInstance(matrix, problemType);
+}
+
+exactsolver::Result solve(const DistanceMatrix<uint16_t>& matrix, const ProblemType problemType) {
+  return solveInstance(matrix, problemType);
+}
+}  // namespace heldkarp
@@ -0,0 +1,117 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "solve/hilbertorder.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// graph library
+#include "geometry.hpp"
+#include "graph.hpp"
+
+#include "solve/approximation.hpp"
+
+#include "utility/perfcounter.hpp"
+
+namespace hilbertorder {
+constexpr unsigned int CURVE_ORDER = 16;  // the bounding box is divided into 2^16 x 2^16 cells, the index fits 32 bit
+constexpr uint32_t CURVE_SIDE      = uint32_t{1} << CURVE_ORDER;
+
+/*!
+ * @brief position of the cell (x, y) along the Hilbert curve
+ */
+static uint32_t hilbertIndex(uint32_t x, uint32_t y) {
+  uint32_t index = 0;
+  for (uint32_t s = CURVE_SIDE / 2; s > 0; s /= 2) {
+    const uint32_t rx = (x & s) > 0;
+    const uint32_t ry = (y & s) > 0;
+    index            += s * s * ((3 * rx) ^ ry);
+    if (ry == 0) {  // rotate the quadrant, so that the curve is continuous
+      if (rx == 1) {
+        x = CURVE_SIDE - 1 - x;
+        y = CURVE_SIDE - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
+
+std::vector<size_t> hilbertOrder(const std::vector<graph::Point2D>& positions) {
+  if (positions.empty()) {
+    return {};
+  }
+  const auto [minX, maxX] = std::minmax_element(positions.begin(), positions.end(), [](const auto& a, const auto& b) { return a.x < b.x; });
+  const auto [minY, maxY] = std::minmax_element(positions.begin(), positions.end(), [](const auto& a, const auto& b) { return a.y < b.y; });
+  const double extent     = std::max({maxX->x - minX->x, maxY->y - minY->y, 1e-300});
+  const double scale      = (CURVE_SIDE - 1) / extent;
+
+  std::vector<std::pair<uint32_t, size_t>> keys(positions.size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    const uint32_t x = static_cast<uint32_t>((positions[i].x - minX->x) * scale);
+    const uint32_t y = static_cast<uint32_t>((positions[i].y - minY->y) * scale);
+    keys[i]          = std::make_pair(hilbertIndex(x, y), i);
+  }
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<size_t> order(positions.size());
+  std::transform(keys.begin(), keys.end(), order.begin(), [](const auto& key) { return key.second; });
+  return order;
+}
+
+Reordering::Reordering(const graph::Euclidean& euclidean) {
+  perfcounter::Scope scope("hilbert order");
+  pOrder = hilbertOrder(euclidean.vertices());
+  pRenumbered.resize(pOrder.size());
+  std::vector<graph::Point2D> positions(pOrder.size());
+  for (size_t i = 0; i < pOrder.size(); ++i) {
+    pRenumbered[pOrder[i]] = i;
+    positions[i]           = euclidean.position(pOrder[i]);
+  }
+  pGraph = graph::Euclidean(positions);
+}
+
+approximation::Result Reordering::restore(approximation::Result&& result) const {
+  perfcounter::Scope scope("restore ids");
+  for (size_t& u : result.tour) {
+    u = pOrder[u];
+  }
+  result.bottleneckEdge = graph::Edge{pOrder[result.bottleneckEdge.u], pOrder[result.bottleneckEdge.v]};
+  // the ears of BTSPP and BTSVPP belong to the five fold graph, whose copies keep the numbering of the original
+  const size_t numberOfNodes = pOrder.size();
+  for (std::vector<size_t>& ear : result.openEarDecomposition.ears) {
+    for (size_t& u : ear) {
+      u = (u < 5 * numberOfNodes ? (u / numberOfNodes) * numberOfNodes + pOrder[u % numberOfNodes] : u);
+    }
+  }
+
+  std::vector<std::vector<size_t>> adjacencyList(result.biconnectedGraph.numberOfNodes());
+  for (size_t u = 0; u < adjacencyList.size(); ++u) {
+    std::vector<size_t>& neighbours = adjacencyList[pOrder[u]];
+    neighbours                      = result.biconnectedGraph.adjacencyList()[u];
+    for (size_t& v : neighbours) {
+      v = pOrder[v];
+    }
+  }
+  result.biconnectedGraph = graph::AdjacencyListGraph(adjacencyList);
+  return std::move(result);
+}
+}  // namespace hilbertorder
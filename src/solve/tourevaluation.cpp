@@ -0,0 +1,115 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "solve/tourevaluation.hpp"
+
+#include <vector>
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#endif
+
+// graph library
+#include "geometry.hpp"
+#include "graph.hpp"
+
+namespace tourevaluation {
+static_assert(sizeof(graph::Point2D) == 2 * sizeof(double), "the kernel reads the coordinates as pairs of doubles");
+
+static double squaredLength(const std::vector<graph::Point2D>& positions, const size_t u, const size_t v) {
+  const double dx = positions[v].x - positions[u].x;
+  const double dy = positions[v].y - positions[u].y;
+  return dx * dx + dy * dy;
+}
+
+/*!
+ * @brief evaluates the edges first ... last - 1 and continues evaluation
+ * @details Edge i runs from tour[i] to tour[i + 1], the successor of the last node is the first one.
+ */
+static void evaluateScalar(const std::vector<graph::Point2D>& positions,
+                           const std::vector<size_t>& tour,
+                           const size_t first,
+                           const size_t last,
+                           Evaluation& evaluation) {
+  for (size_t i = first; i < last; ++i) {
+    const double squared = squaredLength(positions, tour[i], tour[i + 1 < tour.size() ? i + 1 : 0]);
+    if (squared > evaluation.bottleneckSquared) {
+      evaluation.bottleneckPosition = i;
+      evaluation.bottleneckSquared  = squared;
+    }
+  }
+}
+
+#if defined(__AVX2__)
+/*!
+ * @brief evaluates four edges per iteration
+ * @details The coordinates of the next four nodes are gathered into tour order directly in the registers, so no
+ * permuted copy of the coordinates is written to memory. Every lane keeps its own maximum and the position of its
+ * first occurrence, the positions are exact as doubles up to 2^53. The lanes are reduced to the first longest edge,
+ * so the result is the one of evaluateScalar().
+ */
+static void evaluateAvx2(const std::vector<graph::Point2D>& positions,
+                         const std::vector<size_t>& tour,
+                         const size_t last,
+                         Evaluation& evaluation) {
+  const double* coordinates = &positions.data()->x;
+  __m256d maxima            = _mm256_set1_pd(-1.0);
+  __m256d maximaPositions   = _mm256_setzero_pd();
+  __m256d edgePositions     = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+  const __m256d step        = _mm256_set1_pd(4.0);
+
+  size_t i = 0;
+  for (; i + 5 <= tour.size() && i + 4 <= last; i += 4) {
+    // indices of x coordinates in the array of pairs, the y coordinates follow directly
+    const __m256i from    = _mm256_slli_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tour.data() + i)), 1);
+    const __m256i to      = _mm256_slli_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tour.data() + i + 1)), 1);
+    const __m256d dx      = _mm256_sub_pd(_mm256_i64gather_pd(coordinates, to, 8), _mm256_i64gather_pd(coordinates, from, 8));
+    const __m256d dy      = _mm256_sub_pd(_mm256_i64gather_pd(coordinates + 1, to, 8), _mm256_i64gather_pd(coordinates + 1, from, 8));
+    const __m256d squared = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+    const __m256d greater = _mm256_cmp_pd(squared, maxima, _CMP_GT_OQ);
+    maxima                = _mm256_blendv_pd(maxima, squared, greater);
+    maximaPositions       = _mm256_blendv_pd(maximaPositions, edgePositions, greater);
+    edgePositions         = _mm256_add_pd(edgePositions, step);
+  }
+
+  alignas(32) double laneMaxima[4], lanePositions[4];
+  _mm256_store_pd(laneMaxima, maxima);
+  _mm256_store_pd(lanePositions, maximaPositions);
+  for (int lane = 0; lane < 4; ++lane) {
+    const size_t position = static_cast<size_t>(lanePositions[lane]);
+    if (laneMaxima[lane] > evaluation.bottleneckSquared ||
+        (laneMaxima[lane] == evaluation.bottleneckSquared && position < evaluation.bottleneckPosition)) {
+      evaluation.bottleneckPosition = position;
+      evaluation.bottleneckSquared  = laneMaxima[lane];
+    }
+  }
+  evaluateScalar(positions, tour, i, last, evaluation);  // remaining edges
+}
+#endif
+
+Evaluation evaluateBottleneck(const std::vector<graph::Point2D>& positions, const std::vector<size_t>& tour, const bool isCycle) {
+  const size_t numberOfEdges = isCycle ? tour.size() : tour.size() - 1;
+  Evaluation evaluation;
+#if defined(__AVX2__)
+  evaluateAvx2(positions, tour, numberOfEdges, evaluation);
+#else
+  evaluateScalar(positions, tour, 0, numberOfEdges, evaluation);
+#endif
+  return evaluation;
+}
+}  // namespace tourevaluation
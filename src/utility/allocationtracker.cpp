@@ -0,0 +1,167 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "utility/allocationtracker.hpp"
+
+#if (ALLOCATION_TRACKING)
+
+  #include <algorithm>
+  #include <cstdint>
+  #include <cstdlib>
+  #include <cstring>
+  #include <new>
+
+/*
+ * Every block is prefixed by a header holding the requested size, so that operator delete can account for the freed bytes
+ * without relying on sized deallocation. The counters are thread local, because blocks may be allocated and freed by
+ * different threads, the live bytes of a thread can become negative.
+ */
+
+static constexpr size_t HEADER_SIZE = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+static thread_local size_t ALLOCATIONS;
+static thread_local size_t BYTES;
+static thread_local int64_t LIVE_BYTES;
+static thread_local int64_t PEAK_BYTES;
+
+static void* allocate(const size_t size, const size_t alignment) noexcept {
+  const size_t offset = std::max(alignment, HEADER_SIZE);
+  if (size > SIZE_MAX - offset - alignment) {
+    return nullptr;  // the block including header and padding isn't representable, size + offset would wrap around
+  }
+  void* block = nullptr;
+  if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    block = std::aligned_alloc(alignment, (size + offset + alignment - 1) / alignment * alignment);
+  }
+  else {
+    block = std::malloc(size + offset);
+  }
+  if (block == nullptr) {
+    return nullptr;
+  }
+  std::memcpy(static_cast<char*>(block) + offset - sizeof(size_t), &size, sizeof(size_t));  // store size in front of user data
+
+  ++ALLOCATIONS;
+  BYTES      += size;
+  LIVE_BYTES += static_cast<int64_t>(size);
+  PEAK_BYTES  = std::max(PEAK_BYTES, LIVE_BYTES);
+  return static_cast<char*>(block) + offset;
+}
+
+static void* allocateOrThrow(const size_t size, const size_t alignment) {
+  void* ptr = allocate(size, alignment);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+static void deallocate(void* ptr, const size_t alignment) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  const size_t offset = std::max(alignment, HEADER_SIZE);
+  size_t size;
+  std::memcpy(&size, static_cast<char*>(ptr) - sizeof(size_t), sizeof(size_t));
+  LIVE_BYTES -= static_cast<int64_t>(size);
+  std::free(static_cast<char*>(ptr) - offset);
+}
+
+namespace allocationtracker {
+void reset() {
+  ALLOCATIONS = 0;
+  BYTES       = 0;
+  LIVE_BYTES  = 0;
+  PEAK_BYTES  = 0;
+}
+
+Statistics read() {
+  return Statistics{ALLOCATIONS, BYTES, static_cast<size_t>(PEAK_BYTES)};
+}
+}  // namespace allocationtracker
+
+/***********************************************************************************************************************
+ *                                          replaceable allocation functions
+ **********************************************************************************************************************/
+
+void* operator new(size_t size) {
+  return allocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void* operator new[](size_t size) {
+  return allocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void* operator new(size_t size, std::align_val_t alignment) {
+  return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return allocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return allocate(size, static_cast<size_t>(alignment));
+}
+
+/***********************************************************************************************************************
+ *                                         replaceable deallocation functions
+ **********************************************************************************************************************/
+
+void operator delete(void* ptr) noexcept {
+  deallocate(ptr, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void operator delete[](void* ptr) noexcept {
+  deallocate(ptr, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void operator delete(void* ptr, size_t) noexcept {
+  deallocate(ptr, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void operator delete[](void* ptr, size_t) noexcept {
+  deallocate(ptr, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  deallocate(ptr, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  deallocate(ptr, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+  deallocate(ptr, static_cast<size_t>(alignment));
+}
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+  deallocate(ptr, static_cast<size_t>(alignment));
+}
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept {
+  deallocate(ptr, static_cast<size_t>(alignment));
+}
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept {
+  deallocate(ptr, static_cast<size_t>(alignment));
+}
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  deallocate(ptr, static_cast<size_t>(alignment));
+}
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  deallocate(ptr, static_cast<size_t>(alignment));
+}
+#endif
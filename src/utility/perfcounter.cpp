@@ -0,0 +1,172 @@
+/*
+ * BTSPP is a tool to solve, approximate and draw instances of BTSVPP,
+ * BTSPP, BTSP and TSP. Drawing is limited to euclidean graphs.
+ * Copyright (C) 2023 Jurek Rostalsky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "utility/perfcounter.hpp"
+
+#if (PERF_COUNTERS)
+
+  #include <algorithm>
+  #include <array>
+  #include <chrono>
+  #include <cstdint>
+  #include <cstring>
+  #include <iomanip>
+  #include <iostream>
+  #include <sstream>
+  #include <string>
+  #include <utility>
+  #include <vector>
+
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+
+  #include "utility/utils.hpp"
+
+namespace perfcounter {
+
+/*!
+ * @brief Stage bundles the accumulated counts of all recordings with the same name
+ */
+struct Stage {
+  std::string name; /**< name of the stage */
+  Counts counts;    /**< accumulated counts */
+  size_t calls;     /**< number of recordings */
+};
+
+/*!
+ * @brief CounterGroup manages one group of perf events measuring the calling thread
+ * @details If the kernel refuses to open the events (e.g. due to perf_event_paranoid), only wall time is recorded.
+ */
+class CounterGroup {
+public:
+  CounterGroup() {
+    constexpr std::array<uint64_t, NUMBER_OF_EVENTS> configs{
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    pFileDescriptors.fill(-1);
+    for (size_t i = 0; i < NUMBER_OF_EVENTS; ++i) {
+      perf_event_attr attributes;
+      std::memset(&attributes, 0, sizeof(attributes));
+      attributes.type           = PERF_TYPE_HARDWARE;
+      attributes.size           = sizeof(attributes);
+      attributes.config         = configs[i];
+      attributes.disabled       = (i == 0 ? 1 : 0);  // only the group leader is enabled explicitly
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv     = 1;
+      attributes.read_format    = PERF_FORMAT_GROUP;
+      pFileDescriptors[i] = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, pFileDescriptors[0], 0));
+      if (pFileDescriptors[i] == -1) {
+        close();
+        printYellow("Warning");
+        std::cout << ": Failed to open hardware performance counters, only time is recorded." << std::endl;
+        return;
+      }
+    }
+    ioctl(pFileDescriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(pFileDescriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  ~CounterGroup() { close(); }
+
+  /*!
+   * @brief reads the current values of all events, all values are 0 if the group could not be opened
+   */
+  std::array<uint64_t, NUMBER_OF_EVENTS> read() const {
+    struct {
+      uint64_t numberOfEvents;
+      std::array<uint64_t, NUMBER_OF_EVENTS> values;
+    } data{0, {}};
+    if (pFileDescriptors[0] != -1 && ::read(pFileDescriptors[0], &data, sizeof(data)) != sizeof(data)) {
+      data.values.fill(0);
+    }
+    return data.values;
+  }
+
+private:
+  void close() {
+    for (int& fileDescriptor : pFileDescriptors) {
+      if (fileDescriptor != -1) {
+        ::close(fileDescriptor);
+        fileDescriptor = -1;
+      }
+    }
+  }
+
+  std::array<int, NUMBER_OF_EVENTS> pFileDescriptors; /**< pFileDescriptors[0] is the group leader */
+};
+
+static thread_local CounterGroup GROUP;
+static thread_local std::vector<Stage> STAGES;
+
+void Scope::start(const char* stage) {
+  pStage        = stage;
+  pStart.events = GROUP.read();
+  pStartTime    = std::chrono::steady_clock::now();
+}
+
+void Scope::stop() {
+  if (pStage == nullptr) {
+    return;
+  }
+  const std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+  const std::array<uint64_t, NUMBER_OF_EVENTS> events          = GROUP.read();
+
+  std::vector<Stage>::iterator it = std::find_if(STAGES.begin(), STAGES.end(), [&](const Stage& s) { return s.name == pStage; });
+  if (it == STAGES.end()) {
+    STAGES.push_back(Stage{pStage, Counts{}, 0});
+    it = STAGES.end() - 1;
+  }
+  it->counts.milliseconds += std::chrono::duration<double, std::milli>(now - pStartTime).count();
+  for (size_t i = 0; i < NUMBER_OF_EVENTS; ++i) {
+    it->counts.events[i] += events[i] - pStart.events[i];
+  }
+  ++it->calls;
+  pStage = nullptr;
+}
+
+void reset() {
+  STAGES.clear();
+}
+
+void print(std::ostream& os) {
+  if (STAGES.empty()) {
+    return;
+  }
+  std::ostringstream table;  // formatted locally, so that the flags and the precision of os stay untouched
+  table << "stage                        ms         cycles   instructions   IPC   cache misses  branch misses\n";
+  for (const Stage& stage : STAGES) {
+    const double ipc = stage.counts.events[0] > 0 ? static_cast<double>(stage.counts.events[1]) / stage.counts.events[0] : 0.0;
+    table << std::left << std::setw(24) << stage.name << std::right << std::fixed << std::setprecision(3) << std::setw(11)
+          << stage.counts.milliseconds << std::setw(15) << stage.counts.events[0] << std::setw(15) << stage.counts.events[1]
+          << std::setprecision(2) << std::setw(6) << ipc << std::setw(15) << stage.counts.events[2] << std::setw(15)
+          << stage.counts.events[3] << "\n";
+  }
+  os << table.str();
+}
+
+void writeToFile(std::ostream& os) {
+  for (const Stage& stage : STAGES) {
+    os << "," << stage.name << "," << stage.counts.milliseconds;
+    for (const uint64_t count : stage.counts.events) {
+      os << "," << count;
+    }
+  }
+}
+}  // namespace perfcounter
+#endif